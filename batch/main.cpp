@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include "simulation/engine.hpp"
+#include "simulation/monte_carlo.hpp"
+#include "simulation/thread_pool.hpp"
+
+struct SceneEntry {
+    const char *name;
+    Scene *(*create)();
+};
+
+static const SceneEntry SCENES[] = {
+        {"default", []() -> Scene * { return new DefaultScene(); }},
+        {"throwing", []() -> Scene * { return new ThrowingScene(); }},
+        {"random", []() -> Scene * { return new RandomScene(); }},
+        {"sideways", []() -> Scene * { return new SideWaysCollisionScene(); }},
+        {"parallel", []() -> Scene * { return new ParallelCollisionScene(); }},
+        {"angled", []() -> Scene * { return new AngledParallelCollisionScene(); }},
+        {"stable", []() -> Scene * { return new StableScene(); }},
+        {"stacking", []() -> Scene * { return new StackingScene(); }},
+        {"contact", []() -> Scene * { return new ContactScene(); }},
+        {"dice_grid", []() -> Scene * { return new DiceGridScene(8, 8, 1); }},
+        {"piles", []() -> Scene * { return new PilesScene(4, 4, 3); }},
+};
+
+void print_usage()
+{
+    fprintf(stderr, "usage: rigid-dice-batch <scene> [steps] [seed]\n"
+                    "       rigid-dice-batch rolls <count> [dice] [threads]\nscenes:");
+    for (auto &scene : SCENES) {
+        fprintf(stderr, " %s", scene.name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/** Steps the scene {argv[1]} as fast as possible and prints the throughput. */
+int step_scene(int argc, char **argv)
+{
+    const SceneEntry *entry = nullptr;
+    for (auto &scene : SCENES) {
+        if (strcmp(argv[1], scene.name) == 0) entry = &scene;
+    }
+    if (!entry) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    uint32_t steps = argc > 2 ? (uint32_t) strtoul(argv[2], nullptr, 10) : 120;
+    uint32_t seed = argc > 3 ? (uint32_t) strtoul(argv[3], nullptr, 10) : 1;
+
+    // scenes draw their random placement from {std::rand}
+    std::srand(seed);
+    Engine engine;
+    engine.change_scene(entry->create());
+    engine.run = true;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t bodies = engine.body_system->bodies.size();
+    printf("%s: %zu bodies, %u steps in %.3f s\n", entry->name, bodies, steps, s);
+    printf("%.1f steps/s, %.1f simulated s/s, %.0f body steps/s\n", steps / s, steps * engine.dt / s,
+           (double) (steps * bodies) / s);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Rolls {argv[3]} dice {argv[2]} times, once for every seed, on all threads and prints the rolls per second and how
+ * often every face came up. */
+int roll_dice(int argc, char **argv)
+{
+    if (argc < 3) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    uint32_t count = (uint32_t) strtoul(argv[2], nullptr, 10);
+    uint32_t dice = argc > 3 ? (uint32_t) strtoul(argv[3], nullptr, 10) : 2;
+    uint32_t threads = argc > 4 ? (uint32_t) strtoul(argv[4], nullptr, 10) : 0;
+
+    // a roll which has not settled after ten seconds is given up
+    const uint32_t MAX_STEPS = 600;
+
+    ThreadPool pool(threads);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Roll> rolls = MonteCarlo::roll(&pool, [dice](uint32_t seed) -> Scene * {
+        return new RollScene(dice, seed);
+    }, 0, count, MAX_STEPS);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint32_t settled = 0;
+    uint32_t truncated = 0;
+    uint64_t steps = 0;
+    // number of times every face came up, over all dice of the settled rolls without truncated steps
+    std::vector<uint32_t> tally;
+    for (auto &roll : rolls) {
+        steps += roll.steps;
+        if (roll.truncated_steps > 0) truncated++;
+        if (!roll.settled || roll.truncated_steps > 0) continue;
+
+        settled++;
+        for (auto &face : roll.faces) {
+            if (face >= tally.size()) tally.resize(face + 1, 0);
+            tally[face]++;
+        }
+    }
+    printf("%u rolls of %u dice on %u threads in %.3f s\n", count, dice, pool.get_thread_count(), s);
+    printf("%.1f rolls/s, %u settled, %u with truncated steps, %.1f steps per roll\n", count / s, settled,
+           truncated, count == 0 ? 0. : (double) steps / count);
+    printf("face:");
+    for (uint32_t i = 0; i < tally.size(); i++) {
+        printf(" %u=%u", i, tally[i]);
+    }
+    printf("\n");
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Steps the scene named on the command line as fast as possible, without a window, and prints the throughput. Or,
+ * given "rolls", rolls dice many times on all threads, see {MonteCarlo}. */
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 5) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    if (strcmp(argv[1], "rolls") == 0) return roll_dice(argc, argv);
+    if (argc > 4) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    return step_scene(argc, argv);
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/broadphase/all_pairs.hpp"
+#include "simulation/broadphase/sweep_and_prune.hpp"
+#include "simulation/broadphase/aabb_tree_broadphase.hpp"
+
+/** Lets {count} cubes fall onto four immovable slabs and measures the pair generation of {broadphase}. */
+static void run(const char *name, uint32_t count, Broadphase *broadphase)
+{
+    const uint32_t ITERATIONS = 30;
+    const double SLAB_SIZE = 40.;
+    const double SLAB_HEIGHT = .4;
+    const double SIZE = 1.;
+
+    std::srand(1);
+    BodySystem body_system;
+    body_system.set_broadphase(broadphase);
+
+    Box slab(0., SLAB_SIZE, SLAB_HEIGHT, SLAB_SIZE);
+    for (uint32_t i = 0; i < 4; i++) {
+        body_system.bodies.emplace_back(
+                glm::dvec3(
+                        ((double) (i % 2) - .5) * SLAB_SIZE, -SLAB_HEIGHT / 2., ((double) (i / 2) - .5) * SLAB_SIZE),
+                &slab);
+    }
+
+    // scatter the cubes in a column above the slabs, with a random falling speed
+    Box cube(1. / 3., SIZE, SIZE, SIZE);
+    std::vector<double> speeds;
+    uint32_t per_layer = (uint32_t) (SLAB_SIZE * SLAB_SIZE) / 4;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t in_layer = i % per_layer;
+        uint32_t side = (uint32_t) sqrt((double) per_layer);
+        body_system.bodies.emplace_back(
+                glm::dvec3(
+                        ((double) (in_layer % side) - .5 * side) * 2. * SIZE + (double) std::rand() / RAND_MAX,
+                        2. + (double) (i / per_layer) * 2. * SIZE + (double) std::rand() / RAND_MAX,
+                        ((double) (in_layer / side) - .5 * side) * 2. * SIZE + (double) std::rand() / RAND_MAX),
+                &cube);
+        speeds.emplace_back(.05 + .1 * (double) std::rand() / RAND_MAX);
+    }
+
+    uint64_t pairs = 0;
+    Timer timer;
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        for (uint32_t j = 0; j < count; j++) {
+            // fall until resting on the slabs
+            RigidBody &body = body_system.bodies[4 + j];
+            body.x.y = std::max(SIZE / 2., body.x.y - speeds[j]);
+        }
+        body_system.broadphase->update(body_system.bodies);
+        pairs += body_system.broadphase->get_pairs().size();
+    }
+    double ms = timer.get_ms();
+
+    printf("%-16s %8u %14.1f %12.4f\n", name, count, (double) pairs / ITERATIONS, ms / ITERATIONS);
+}
+
+void aabb_tree_benchmark()
+{
+    printf("%-16s %8s %14s %12s\n", "broadphase", "cubes", "pairs", "ms/update");
+    for (uint32_t count = 1000; count <= 8000; count *= 2) {
+        run("all pairs", count, new AllPairs(Engine::DISTANCE_THRESHOLD));
+        run("sweep and prune", count, new SweepAndPrune(Engine::DISTANCE_THRESHOLD));
+        run("aabb tree", count, new AabbTreeBroadphase(Engine::DISTANCE_THRESHOLD));
+    }
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#include "bench.hpp"
+
+std::atomic<uint64_t> allocation_count(0);
+
+void *operator new(std::size_t size)
+{
+    allocation_count++;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (!p) throw std::bad_alloc();
+
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+Timer::Timer() : start(std::chrono::steady_clock::now())
+{}
+
+void Timer::reset()
+{
+    start = std::chrono::steady_clock::now();
+}
+
+double Timer::get_ms() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+Shape create_sphere(uint32_t rings, uint32_t segments)
+{
+    std::vector<glm::dvec3> vertices;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    std::vector<std::vector<std::pair<uint32_t, glm::vec2>>> faces;
+
+    // index of vertex {j} on ring {i}
+    auto ring = [segments](uint32_t i, uint32_t j) { return 2 + i * segments + j % segments; };
+
+    vertices.emplace_back(0., .5, 0.);
+    vertices.emplace_back(0., -.5, 0.);
+    for (uint32_t i = 0; i < rings; i++) {
+        double theta = M_PI * (i + 1.) / (rings + 1.);
+        for (uint32_t j = 0; j < segments; j++) {
+            double phi = 2. * M_PI * j / segments;
+            vertices.emplace_back(.5 * sin(theta) * cos(phi), .5 * cos(theta), .5 * sin(theta) * sin(phi));
+        }
+    }
+
+    for (uint32_t j = 0; j < segments; j++) {
+        edges.emplace_back(0, ring(0, j));
+        edges.emplace_back(1, ring(rings - 1, j));
+        faces.push_back({{0, {}}, {ring(0, j + 1), {}}, {ring(0, j), {}}});
+        faces.push_back({{1, {}}, {ring(rings - 1, j), {}}, {ring(rings - 1, j + 1), {}}});
+        for (uint32_t i = 0; i < rings; i++) {
+            edges.emplace_back(ring(i, j), ring(i, j + 1));
+            if (i + 1 == rings) continue;
+            edges.emplace_back(ring(i, j), ring(i + 1, j));
+            faces.push_back({{ring(i, j), {}}, {ring(i, j + 1), {}}, {ring(i + 1, j + 1), {}}, {ring(i + 1, j), {}}});
+        }
+    }
+
+    return {vertices, edges, faces};
+}
+
+Sphere::Sphere(
+        double p_inv_mass, double size, const Shape *p_body
+) :
+        ShapeWithMass(p_inv_mass, size, size, size)
+{
+    inv_moment_of_inertia = glm::identity<glm::dmat3>() * (10. * inv_mass / (size * size));
+    body = p_body;
+}
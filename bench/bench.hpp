@@ -0,0 +1,106 @@
+#ifndef BENCH_BENCH_HPP
+#define BENCH_BENCH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "simulation/rigid_body.hpp"
+
+/** Number of calls to operator new in the benchmark executable, counted by its replacement in bench.cpp. */
+extern std::atomic<uint64_t> allocation_count;
+
+/** Measures wall time since construction or the last call to {reset}. */
+class Timer {
+private:
+    std::chrono::steady_clock::time_point start;
+public:
+    Timer();
+
+    void reset();
+
+    /** Elapsed time in milliseconds. */
+    double get_ms() const;
+};
+
+/**
+ * Sphere approximated by {rings} rings of {segments} vertices, closed by a vertex at either pole, such that it has
+ * many vertices with a low degree. The faces between two rings are quads, the faces at the poles are triangles. */
+Shape create_sphere(uint32_t rings, uint32_t segments);
+
+/** Sphere of {create_sphere}, with the moment of inertia of a solid sphere. */
+class Sphere : public ShapeWithMass {
+public:
+    Sphere(double p_inv_mass, double size, const Shape *p_body);
+};
+
+/*
+ * Benchmarks, each prints its results as a table to stdout.
+ */
+
+/** Compares the sweep and prune broadphase against testing all pairs. */
+void broadphase_benchmark();
+
+/** Scaling of pair generation of the bounding volume hierarchy, when many cubes fall onto a few large slabs. */
+void aabb_tree_benchmark();
+
+/** Compares the spatial hash broadphase against testing all pairs, on a 32x32 grid of falling cubes. */
+void spatial_hash_benchmark();
+
+/** Hit rate and gain of caching the separating feature of every pair, on towers of resting cubes. */
+void feature_cache_benchmark();
+
+/** Compares the separating plane scan against GJK on random pairs of cubes and icosahedrons. */
+void narrowphase_benchmark();
+
+/** Compares finding the extreme vertices by iterating all vertices against hill climbing, on spheres. */
+void support_benchmark();
+
+/** Vertices classified against a plane per second, one vertex at a time and with {PlaneKernel}. */
+void plane_kernel_benchmark();
+
+/** Pivots of the contact force solver per step, with and without the forces of the previous step as guess. */
+void warm_start_benchmark();
+
+/** Solving the contact forces of all resting cubes at once against solving every island apart. */
+void island_benchmark();
+
+/** Speedup over one thread of stepping and of solving the islands of 64 separate piles of cubes on multiple threads. */
+void thread_pool_benchmark();
+
+/** Assembly of the contact matrix of cubes resting on a table, dense against sparse. */
+void sparse_matrix_benchmark();
+
+/** Refactorizing A_CC at every pivot of {math::qp_solve} against updating the factorization, on random problems. */
+void qp_solve_benchmark();
+
+/** Heap allocations of the contact force solver once its workspace has grown, counted through operator new. */
+void solver_workspace_benchmark();
+
+/** Residual against time of the pivoting and the iterative contact force solver, on resting piles of cubes. */
+void contact_solver_benchmark();
+
+/**
+ * Time and allocations of applying the forces and integrating up to 10k free bodies, on the {RigidBody} objects
+ * against on {BodyState}. */
+void integrator_benchmark();
+
+/** Accuracy and time of integrating orientation as rotation matrix against as unit quaternion. */
+void orientation_benchmark();
+
+/** Steady state time per step of 500 cubes at rest on a table, with and without putting them to sleep. */
+void sleeping_benchmark();
+
+/**
+ * Searches of the time of collision and repeated integrations of all bodies for them, of cubes thrown onto a table,
+ * by conservative advancement of the interpenetrating pairs against bisection of the whole system. */
+void time_of_impact_benchmark();
+
+/** Bodies integrated per step of cubes landing on a table, re-integrating all of them or only those near an impact. */
+void localized_substep_benchmark();
+
+/** Rolls per second of two dice thrown onto a table, each roll until both settle, by number of threads. */
+void monte_carlo_benchmark();
+
+#endif //BENCH_BENCH_HPP
@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/broadphase/all_pairs.hpp"
+#include "simulation/broadphase/sweep_and_prune.hpp"
+
+/** Runs {CollisionDetection::intersect} {iterations} times while the bodies slowly fall. */
+static void run(const char *name, Scene *scene, Broadphase *broadphase, uint32_t iterations)
+{
+    std::srand(1);
+    BodySystem *body_system = scene->initialize();
+    body_system->set_broadphase(broadphase);
+
+    uint64_t pair_tests = 0;
+    Timer timer;
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (auto &body : body_system->bodies) {
+            if (body.shape->get_inv_mass() != 0.) body.x.y -= .001;
+        }
+        if (CollisionDetection::intersect(body_system)) {
+            printf("unexpected intersection\n");
+        }
+        pair_tests += body_system->broadphase->get_pairs().size();
+    }
+    double ms = timer.get_ms();
+
+    printf("%-16s %8zu %14.1f %12.4f\n",
+           name, body_system->bodies.size(), (double) pair_tests / iterations, ms / iterations);
+
+    delete body_system;
+}
+
+void broadphase_benchmark()
+{
+    const uint32_t ITERATIONS = 20;
+    // (count_x, count_z, layers) such that there are 10, 100, and 1000 cubes
+    const uint32_t DIMENSIONS[][3] = {{5, 2, 1}, {10, 10, 1}, {10, 10, 10}};
+
+    printf("%-16s %8s %14s %12s\n", "broadphase", "bodies", "pair tests", "ms/step");
+    for (auto &dimension : DIMENSIONS) {
+        DiceGridScene scene(dimension[0], dimension[1], dimension[2]);
+        run("all pairs", &scene, new AllPairs(Engine::DISTANCE_THRESHOLD), ITERATIONS);
+        run("sweep and prune", &scene, new SweepAndPrune(Engine::DISTANCE_THRESHOLD), ITERATIONS);
+    }
+}
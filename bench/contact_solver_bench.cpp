@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** The contact force problem of an island: A and b, with a zero guess. */
+struct Problem {
+    math::SparseMatrix amat;
+    std::vector<double> bvec;
+};
+
+/** The problems of the islands of {scene} after {steps} steps, in which the cubes rest. */
+static std::vector<Problem> create_problems(Scene *scene, uint32_t steps)
+{
+    Engine engine;
+    engine.sleeping = false;
+    engine.change_scene(scene);
+    engine.run = true;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+
+    std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(engine.body_system);
+    Integrator::apply_forces(engine.body_system);
+
+    std::vector<Problem> problems;
+    math::SolverWorkspace workspace;
+    for (auto &island : Island::find_islands(contacts, engine.body_system->bodies)) {
+        problems.emplace_back();
+        problems.back().bvec.resize(island.size());
+        CollisionHandling::compute_b_vector(engine.body_system, problems.back().bvec.data(), island);
+        CollisionHandling::compute_a_matrix(&problems.back().amat, island, &workspace);
+    }
+
+    for (auto &contact : contacts) {
+        delete contact;
+    }
+
+    return problems;
+}
+
+/**
+ * Solves all {problems} {repetitions} times, with {math::qp_solve} if {iterations} is zero and with that many
+ * sweeps of {math::pgs_solve} otherwise, and prints the time and the largest residual. */
+static void run(const char *name, const std::vector<Problem> &problems, uint32_t iterations, uint32_t repetitions)
+{
+    math::SolverWorkspace workspace;
+    std::vector<double> fvec;
+    double residual = 0.;
+    Timer timer;
+    for (uint32_t k = 0; k < repetitions; k++) {
+        for (auto &problem : problems) {
+            fvec.assign(problem.amat.n, 0.);
+            if (iterations == 0) {
+                math::qp_solve(problem.amat, problem.bvec.data(), fvec.data(), problem.amat.n, &workspace);
+            } else {
+                math::pgs_solve(problem.amat, problem.bvec.data(), fvec.data(), problem.amat.n, iterations, 0.,
+                                &workspace);
+            }
+        }
+    }
+    double ms = timer.get_ms() / repetitions;
+
+    for (auto &problem : problems) {
+        fvec.assign(problem.amat.n, 0.);
+        if (iterations == 0) {
+            math::qp_solve(problem.amat, problem.bvec.data(), fvec.data(), problem.amat.n, &workspace);
+        } else {
+            math::pgs_solve(problem.amat, problem.bvec.data(), fvec.data(), problem.amat.n, iterations, 0.,
+                            &workspace);
+        }
+        residual = std::max(residual, math::lcp_residual(
+                problem.amat, problem.bvec.data(), fvec.data(), workspace.avec.data(), problem.amat.n));
+    }
+
+    char solver[32];
+    if (iterations == 0) {
+        snprintf(solver, sizeof(solver), "dantzig");
+    } else {
+        snprintf(solver, sizeof(solver), "pgs %u", iterations);
+    }
+    printf("%-12s %-12s %10.3f %12.3e\n", name, solver, ms, residual);
+}
+
+void contact_solver_benchmark()
+{
+    const uint32_t REPETITIONS = 5;
+
+    printf("%-12s %-12s %10s %12s\n", "scene", "solver", "ms", "residual");
+    std::vector<Problem> piles = create_problems(new PilesScene(4, 4, 3), 2);
+    std::vector<Problem> block = create_problems(new PilesScene(1, 1, 8), 2);
+    for (uint32_t iterations : {0, 5, 10, 20, 50, 100, 200}) {
+        run("16 piles", piles, iterations, REPETITIONS);
+    }
+    for (uint32_t iterations : {0, 5, 10, 20, 50, 100, 200}) {
+        run("8x8 block", block, iterations, REPETITIONS);
+    }
+}
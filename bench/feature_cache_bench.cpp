@@ -0,0 +1,78 @@
+#include <cinttypes>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/separating_feature_cache.hpp"
+
+/**
+ * Finds all contacts of towers of resting cubes {iterations} times, while the cubes jitter slightly
+ * as they would in a resting stack. */
+static void run(const char *name, bool enabled, uint32_t iterations)
+{
+    const uint32_t TOWERS = 10;
+    const uint32_t HEIGHT = 5;
+    const double SIZE = 1.;
+    // within {Engine::DISTANCE_THRESHOLD}, such that every cube is in contact with the one below
+    const double GAP = .01;
+    const double JITTER = .001;
+
+    std::srand(1);
+    BodySystem body_system;
+    body_system.feature_cache->enabled = enabled;
+
+    Box surface(0., 3. * SIZE * TOWERS, .4, 3. * SIZE * TOWERS);
+    body_system.bodies.emplace_back(glm::dvec3(0., -.2, 0.), &surface);
+
+    Box cube(1. / 3., SIZE, SIZE, SIZE);
+    for (uint32_t i = 0; i < TOWERS; i++) {
+        for (uint32_t j = 0; j < TOWERS; j++) {
+            for (uint32_t k = 0; k < HEIGHT; k++) {
+                body_system.bodies.emplace_back(
+                        glm::dvec3(
+                                ((double) i - .5 * TOWERS) * 2. * SIZE,
+                                .5 * SIZE + GAP + (double) k * (SIZE + GAP),
+                                ((double) j - .5 * TOWERS) * 2. * SIZE),
+                        &cube);
+            }
+        }
+    }
+
+    // the test performed at every iteration of the bisection, every pair is separated
+    Timer timer;
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (uint32_t j = 1; j < body_system.bodies.size(); j++) {
+            // slide horizontally, keeping the faces in contact
+            body_system.bodies[j].x.x += JITTER * ((double) std::rand() / RAND_MAX - .5);
+            body_system.bodies[j].x.z += JITTER * ((double) std::rand() / RAND_MAX - .5);
+        }
+        if (CollisionDetection::intersect(&body_system)) {
+            printf("unexpected intersection\n");
+        }
+    }
+    double ms = timer.get_ms();
+    printf("%-16s %-10s %10" PRIu64 " %10" PRIu64 " %12.4f\n", name, "intersect",
+           body_system.feature_cache->get_hits(), body_system.feature_cache->get_misses(), ms / iterations);
+
+    // finding the contacts additionally requires the pairs in contact to be proven to intersect,
+    // for which the full scan is always required
+    body_system.feature_cache->reset_counts();
+    timer.reset();
+    for (uint32_t i = 0; i < iterations; i++) {
+        std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(&body_system);
+        for (auto &contact : contacts) {
+            delete contact;
+        }
+    }
+    ms = timer.get_ms();
+    printf("%-16s %-10s %10" PRIu64 " %10" PRIu64 " %12.4f\n", name, "contacts",
+           body_system.feature_cache->get_hits(), body_system.feature_cache->get_misses(), ms / iterations);
+}
+
+void feature_cache_benchmark()
+{
+    const uint32_t ITERATIONS = 50;
+
+    printf("%-16s %-10s %10s %10s %12s\n", "cache", "routine", "hits", "misses", "ms/call");
+    run("full scan", false, ITERATIONS);
+    run("feature cache", true, ITERATIONS);
+}
@@ -0,0 +1,169 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/force/gravity_force.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Sets the auxiliary quantities of {body} from its quantities, as {Integrator::runge_kutta_4} did. */
+static void compute_auxiliary(RigidBody *body)
+{
+    body->v = body->p * body->shape->get_inv_mass();
+    glm::dmat3 a = body->get_rotation();
+    body->i_inv = a * body->shape->get_inv_moment_of_inertia() * glm::transpose(a);
+    body->omega = body->i_inv * body->l;
+}
+
+/** Sets {k} to the change of the quantities of {bodies} over {dt}, as {Integrator::runge_kutta_4} did. */
+static void compute_delta(std::vector<RigidBody> *bodies, std::vector<RigidBody> *k, double dt)
+{
+    for (auto &body : *bodies) {
+        body.x = dt * body.v;
+        body.p = dt * body.force;
+        body.q = dt * Integrator::spin(body.omega, body.q);
+        body.l = dt * body.torque;
+        compute_auxiliary(&body);
+    }
+    *k = *bodies;
+}
+
+/** Fourth order Runge Kutta on the {RigidBody} objects, as done before {BodyState}. */
+static void runge_kutta_4_bodies(BodySystem *body_system, double dt)
+{
+    std::vector<RigidBody> &bodies = body_system->bodies;
+    std::vector<RigidBody> initial_state = bodies;
+    std::vector<RigidBody> k1, k2, k3, k4;
+
+    compute_delta(&bodies, &k1, dt);
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        bodies[i].x = initial_state[i].x + .5 * k1[i].x;
+        bodies[i].p = initial_state[i].p + .5 * k1[i].p;
+        bodies[i].q = glm::normalize(initial_state[i].q + .5 * k1[i].q);
+        bodies[i].l = initial_state[i].l + .5 * k1[i].l;
+        compute_auxiliary(&bodies[i]);
+    }
+    compute_delta(&bodies, &k2, dt);
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        bodies[i].x = initial_state[i].x + .5 * k2[i].x;
+        bodies[i].p = initial_state[i].p + .5 * k2[i].p;
+        bodies[i].q = glm::normalize(initial_state[i].q + .5 * k2[i].q);
+        bodies[i].l = initial_state[i].l + .5 * k2[i].l;
+        compute_auxiliary(&bodies[i]);
+    }
+    compute_delta(&bodies, &k3, dt);
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        bodies[i].x = initial_state[i].x + k3[i].x;
+        bodies[i].p = initial_state[i].p + k3[i].p;
+        bodies[i].q = glm::normalize(initial_state[i].q + k3[i].q);
+        bodies[i].l = initial_state[i].l + k3[i].l;
+        compute_auxiliary(&bodies[i]);
+    }
+    compute_delta(&bodies, &k4, dt);
+
+    const double F16 = 1. / 6.;
+    const double F13 = 1. / 3.;
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        bodies[i].x = initial_state[i].x + F16 * k1[i].x + F13 * k2[i].x + F13 * k3[i].x + F16 * k4[i].x;
+        bodies[i].p = initial_state[i].p + F16 * k1[i].p + F13 * k2[i].p + F13 * k3[i].p + F16 * k4[i].p;
+        bodies[i].q = initial_state[i].q + F16 * k1[i].q + F13 * k2[i].q + F13 * k3[i].q + F16 * k4[i].q;
+        bodies[i].l = initial_state[i].l + F16 * k1[i].l + F13 * k2[i].l + F13 * k3[i].l + F16 * k4[i].l;
+        bodies[i].q = glm::normalize(bodies[i].q);
+        compute_auxiliary(&bodies[i]);
+    }
+}
+
+/** Fills {body_system} with {count} spinning, moving cubes under gravity, with no contacts. */
+static void create_bodies(BodySystem *body_system, const ShapeWithMass *shape, uint32_t count)
+{
+    std::srand(1);
+    for (uint32_t i = 0; i < count; i++) {
+        glm::dvec3 axis = glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit()));
+        glm::dmat3 a(glm::rotate(glm::identity<glm::dmat4>(), random_unit(), axis));
+        glm::dvec3 p(random_unit(), random_unit(), random_unit());
+        glm::dvec3 l(random_unit(), random_unit(), random_unit());
+        body_system->bodies.emplace_back(glm::dvec3(3. * i, 0., 0.), a, p, l, shape);
+    }
+    body_system->forces.emplace_back(new GravityForce(body_system));
+}
+
+/** Result of stepping one layout. */
+struct Run {
+    double ms;
+    double allocations;
+};
+
+/**
+ * Steps {aos} {steps} times on the {RigidBody} objects as done before, with a copy to restore the bodies from and a
+ * repeated step, as a search for the time of collision does. */
+static Run run_bodies(BodySystem *aos, uint32_t steps, double dt)
+{
+    uint64_t allocations = allocation_count;
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        // the forces are applied as the engine does, only the integration is on the {RigidBody} objects
+        Integrator::apply_forces(aos);
+        aos->body_state.store_forces(&aos->bodies);
+        std::vector<RigidBody> bodies_t0 = aos->bodies;
+        runge_kutta_4_bodies(aos, dt);
+        aos->bodies = bodies_t0;
+        runge_kutta_4_bodies(aos, dt);
+    }
+
+    return {timer.get_ms() / steps, (double) (allocation_count - allocations) / steps};
+}
+
+/** Steps {soa} {steps} times on {BodyState}, with a repeated step. */
+static Run run_state(BodySystem *soa, uint32_t steps, double dt)
+{
+    uint64_t allocations = allocation_count;
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        Integrator::apply_forces(soa);
+        Integrator::runge_kutta_4(soa, dt);
+        Integrator::repeat_runge_kutta_4(soa, dt);
+    }
+
+    return {timer.get_ms() / steps, (double) (allocation_count - allocations) / steps};
+}
+
+/**
+ * Steps free bodies by applying the forces and integrating twice, on the {RigidBody} objects as done before and on
+ * {BodyState}. Both are stepped once before measuring, such that {BodyState} has grown. The bandwidth counts the
+ * quantities read and written per body by the state update alone, such that both are compared on the same amount
+ * of useful traffic. */
+void integrator_benchmark()
+{
+    const double DT = 1. / 60.;
+    Box cube(1., 1., 1., 1.);
+
+    printf("sizeof(RigidBody): %zu\n", sizeof(RigidBody));
+    printf("%8s %12s %12s %12s %12s %12s %12s %10s\n", "bodies", "ms body", "ms state", "GB/s body",
+           "GB/s state", "alloc body", "alloc state", "identical");
+    for (uint32_t count : {1, 100, 10000}) {
+        uint32_t steps = 200000 / count + 10;
+        BodySystem aos;
+        create_bodies(&aos, &cube, count);
+        run_bodies(&aos, 1, DT);
+        Run body_run = run_bodies(&aos, steps, DT);
+
+        BodySystem soa;
+        create_bodies(&soa, &cube, count);
+        run_state(&soa, 1, DT);
+        Run state_run = run_state(&soa, steps, DT);
+
+        bool identical = true;
+        for (uint32_t i = 0; i < count; i++) {
+            if (aos.bodies[i].x != soa.bodies[i].x || aos.bodies[i].q != soa.bodies[i].q) identical = false;
+        }
+
+        // both steps have four stages, which read and write x, p, q, l and the auxiliary quantities once
+        double body_bytes = 5. * sizeof(glm::dvec3) + sizeof(glm::dquat) + sizeof(glm::dmat3);
+        double bytes = 2. * 4. * count * 2. * body_bytes;
+        printf("%8u %12.4f %12.4f %12.2f %12.2f %12.1f %12.1f %10s\n", count, body_run.ms, state_run.ms,
+               1e-6 * bytes / body_run.ms, 1e-6 * bytes / state_run.ms, body_run.allocations,
+               state_run.allocations, identical ? "yes" : "no");
+    }
+}
@@ -0,0 +1,77 @@
+#include <cinttypes>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** Cubes resting apart on a {count} by {count} grid on an immovable surface, as in {StableScene}. */
+class RestingGridScene : public Scene {
+private:
+    uint32_t count;
+public:
+    explicit RestingGridScene(uint32_t p_count) : count(p_count)
+    {}
+
+    BodySystem *initialize() override
+    {
+        auto bs = new BodySystem();
+
+        const double HEIGHT = .4;
+        const double SIZE = 1.;
+        const ShapeWithMass *surface = new Box(0., 2. * SIZE * count + SIZE, HEIGHT, 2. * SIZE * count + SIZE);
+        shapes.emplace_back(surface);
+        bs->bodies.emplace_back(glm::dvec3(0., -HEIGHT / 2., 0.), surface);
+
+        const double MASS = .1;
+        const ShapeWithMass *cube = new Box(1. / MASS, SIZE, SIZE, SIZE);
+        shapes.emplace_back(cube);
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t j = 0; j < count; j++) {
+                bs->bodies.emplace_back(glm::dvec3(
+                        SIZE * 2. * (i - .5 * (count - 1)), SIZE / 2, SIZE * 2. * (j - .5 * (count - 1))), cube);
+            }
+        }
+
+        bs->forces.emplace_back(new GravityForce(bs));
+
+        return bs;
+    }
+};
+
+/** Steps {count} by {count} resting cubes {steps} times, solving all contacts at once or every island apart. */
+static void run(uint32_t count, bool islands, uint32_t steps)
+{
+    Engine engine;
+    engine.warm_start = false;
+    engine.sleeping = false;
+    engine.islands = islands;
+    engine.change_scene(new RestingGridScene(count));
+    engine.run = true;
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms();
+
+    const IslandStatistics &statistics = engine.body_system->island_statistics;
+    printf("%6u %-8s %10.3f %10.2f %10.2f %10u  ", count * count, islands ? "islands" : "single", ms / steps,
+           (double) engine.pivots / steps,
+           statistics.calls ? (double) statistics.islands / statistics.calls : 1., statistics.largest);
+    for (uint32_t k = 0; k < statistics.histogram.size(); k++) {
+        if (statistics.histogram[k]) printf(" %u:%" PRIu64, 1u << k, statistics.histogram[k]);
+    }
+    printf("\n");
+}
+
+void island_benchmark()
+{
+    // without warm starting, such that every step solves from scratch
+    const uint32_t STEPS = 20;
+
+    printf("%6s %-8s %10s %10s %10s %10s  %s\n",
+           "cubes", "solver", "ms/step", "pivots", "islands", "largest", "histogram (size:count)");
+    for (uint32_t count : {3, 6, 9}) {
+        run(count, false, STEPS);
+        run(count, true, STEPS);
+    }
+}
@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/**
+ * Steps {count} by {count} randomly oriented cubes falling onto a table for {steps} steps, with or without
+ * localized substeps. Returns the time per step in milliseconds and stores the number of searches of the time of
+ * collision and the number of bodies integrated. */
+static double run(bool localized_substeps, uint32_t count, uint32_t steps, uint64_t *impacts,
+                  uint64_t *integrated_bodies)
+{
+    std::srand(1);
+    Engine engine;
+    engine.threads = 1;
+    engine.localized_substeps = localized_substeps;
+    engine.change_scene(new DiceGridScene(count, count, 1));
+    engine.run = true;
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms() / steps;
+
+    *impacts = engine.impacts;
+    *integrated_bodies = engine.integrated_bodies;
+
+    return ms;
+}
+
+void localized_substep_benchmark()
+{
+    // the cubes land after about 25 steps, at different times as they are oriented differently
+    const uint32_t STEPS = 60;
+
+    printf("%8s %10s %10s %16s %10s\n", "bodies", "localized", "impacts", "integrated/step", "ms/step");
+    for (uint32_t count : {4, 8}) {
+        for (bool localized_substeps : {false, true}) {
+            uint64_t impacts, integrated_bodies;
+            double ms = run(localized_substeps, count, STEPS, &impacts, &integrated_bodies);
+            printf("%8u %10s %10lu %16.1f %10.3f\n", count * count, localized_substeps ? "yes" : "no",
+                   (unsigned long) impacts, (double) integrated_bodies / STEPS, ms);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include "bench.hpp"
+
+struct Benchmark {
+    const char *name;
+    void (*run)();
+};
+
+static const Benchmark BENCHMARKS[] = {
+        {"broadphase", broadphase_benchmark},
+        {"aabb_tree", aabb_tree_benchmark},
+        {"spatial_hash", spatial_hash_benchmark},
+        {"feature_cache", feature_cache_benchmark},
+        {"narrowphase", narrowphase_benchmark},
+        {"support", support_benchmark},
+        {"plane_kernel", plane_kernel_benchmark},
+        {"warm_start", warm_start_benchmark},
+        {"island", island_benchmark},
+        {"thread_pool", thread_pool_benchmark},
+        {"sparse_matrix", sparse_matrix_benchmark},
+        {"qp_solve", qp_solve_benchmark},
+        {"solver_workspace", solver_workspace_benchmark},
+        {"contact_solver", contact_solver_benchmark},
+        {"integrator", integrator_benchmark},
+        {"orientation", orientation_benchmark},
+        {"sleeping", sleeping_benchmark},
+        {"time_of_impact", time_of_impact_benchmark},
+        {"localized_substep", localized_substep_benchmark},
+        {"monte_carlo", monte_carlo_benchmark},
+};
+
+/** Runs the benchmarks named on the command line, or all of them if none are named. */
+int main(int argc, char **argv)
+{
+    for (auto &benchmark : BENCHMARKS) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], benchmark.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        printf("== %s ==\n", benchmark.name);
+        benchmark.run();
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#include <thread>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/monte_carlo.hpp"
+#include "simulation/thread_pool.hpp"
+
+void monte_carlo_benchmark()
+{
+    const uint32_t ROLLS = 64;
+    const uint32_t DICE = 2;
+    const uint32_t MAX_STEPS = 600;
+
+    // one, two, four, ... threads up to the number of hardware threads, and the number of hardware threads itself
+    std::vector<uint32_t> thread_counts;
+    uint32_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    for (uint32_t threads = 1; threads < hardware; threads *= 2) {
+        thread_counts.emplace_back(threads);
+    }
+    thread_counts.emplace_back(hardware);
+
+    printf("%8s %8s %10s %10s %10s %10s\n", "threads", "settled", "truncated", "steps", "rolls/s", "speedup");
+    double base = 0.;
+    for (uint32_t threads : thread_counts) {
+        ThreadPool pool(threads);
+        Timer timer;
+        std::vector<Roll> rolls = MonteCarlo::roll(&pool, [](uint32_t seed) -> Scene * {
+            return new RollScene(DICE, seed);
+        }, 0, ROLLS, MAX_STEPS);
+        double rate = ROLLS / (timer.get_ms() * 1.e-3);
+        if (threads == 1) base = rate;
+
+        uint32_t settled = 0;
+        uint32_t truncated = 0;
+        uint64_t steps = 0;
+        for (auto &roll : rolls) {
+            if (roll.settled) settled++;
+            if (roll.truncated_steps > 0) truncated++;
+            steps += roll.steps;
+        }
+        printf("%8u %8u %10u %10lu %10.1f %10.2f\n", threads, settled, truncated, (unsigned long) steps, rate,
+               rate / base);
+    }
+}
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/gjk.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Random orientation. */
+static glm::dmat3 random_orientation()
+{
+    glm::dvec3 axis(random_unit(), random_unit(), random_unit() + 2.);
+    return glm::dmat3(glm::rotate(glm::identity<glm::dmat4>(), M_PI * random_unit(), glm::normalize(axis)));
+}
+
+/**
+ * Tests {count} random configurations of a pair of {shape_x} and {shape_y} with SAT and GJK. The bodies are
+ * placed at random directions and distances, such that roughly half of the pairs intersect. */
+static void run(const char *name, const ShapeWithMass *shape_x, const ShapeWithMass *shape_y, uint32_t count)
+{
+    std::srand(1);
+    std::vector<RigidBody> bodies;
+    for (uint32_t i = 0; i < count; i++) {
+        glm::dvec3 direction = glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit()));
+        bodies.emplace_back(glm::dvec3(0.), random_orientation(), shape_x);
+        bodies.emplace_back(direction * (.8 + 1.2 * (double) std::rand() / RAND_MAX), random_orientation(), shape_y);
+    }
+
+    // yes or no queries
+    uint32_t sat_intersections = 0;
+    Timer timer;
+    for (uint32_t i = 0; i < count; i++) {
+        if (Collision::intersect(&bodies[2 * i], &bodies[2 * i + 1], 0.).intersect) sat_intersections++;
+    }
+    double sat_ms = timer.get_ms();
+
+    uint32_t gjk_intersections = 0;
+    timer.reset();
+    for (uint32_t i = 0; i < count; i++) {
+        if (Gjk::overlap(&bodies[2 * i], &bodies[2 * i + 1], 0.)) gjk_intersections++;
+    }
+    double gjk_ms = timer.get_ms();
+
+    // queries that also find the separating plane, which the engine only performs for separated pairs
+    std::vector<uint32_t> separated;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!Gjk::overlap(&bodies[2 * i], &bodies[2 * i + 1], 0.)) separated.emplace_back(i);
+    }
+
+    timer.reset();
+    for (auto &i : separated) {
+        Collision::intersect(&bodies[2 * i], &bodies[2 * i + 1], 0.);
+    }
+    double sat_plane_ms = timer.get_ms();
+
+    uint32_t agree = 0;
+    timer.reset();
+    for (auto &i : separated) {
+        if (!Gjk::intersect(&bodies[2 * i], &bodies[2 * i + 1], 0.).intersect) agree++;
+    }
+    double gjk_plane_ms = timer.get_ms();
+
+    printf("%-24s %8u %8u %8u %10.3f %10.3f %10.3f %10.3f\n", name, sat_intersections, gjk_intersections, agree,
+           1e3 * sat_ms / count, 1e3 * gjk_ms / count,
+           1e3 * sat_plane_ms / separated.size(), 1e3 * gjk_plane_ms / separated.size());
+}
+
+void narrowphase_benchmark()
+{
+    const uint32_t COUNT = 20000;
+    Box cube(1., 1., 1., 1.);
+    Icosahedron icosahedron(1., 1., 1., 1.);
+
+    // number of intersecting pairs according to either, and the number of separated pairs for which GJK finds
+    // a separating plane, followed by the time per query
+    printf("%-24s %8s %8s %8s %10s %10s %10s %10s\n",
+           "pair", "sat", "gjk", "planes", "us/sat", "us/gjk", "us/sat pl", "us/gjk pl");
+    run("cube-cube", &cube, &cube, COUNT);
+    run("cube-icosahedron", &cube, &icosahedron, COUNT);
+    run("icosahedron-icosahedron", &icosahedron, &icosahedron, COUNT);
+}
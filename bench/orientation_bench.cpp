@@ -0,0 +1,121 @@
+#include <cmath>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Angular velocity of a body with orientation {a}, angular momentum {l} and body space inverse inertia {i}. */
+static glm::dvec3 angular_velocity(const glm::dmat3 &a, glm::dvec3 l, const glm::dmat3 &i)
+{
+    return a * i * glm::transpose(a) * l;
+}
+
+/** One torque free fourth order Runge Kutta step of rotation matrix {a}, orthonormalized at every stage. */
+static glm::dmat3 step_matrix(const glm::dmat3 &a, glm::dvec3 l, const glm::dmat3 &i, double dt)
+{
+    glm::dmat3 k1 = dt * Integrator::star(angular_velocity(a, l, i)) * a;
+    glm::dmat3 a2 = glm::orthonormalize(a + .5 * k1);
+    glm::dmat3 k2 = dt * Integrator::star(angular_velocity(a2, l, i)) * a2;
+    glm::dmat3 a3 = glm::orthonormalize(a + .5 * k2);
+    glm::dmat3 k3 = dt * Integrator::star(angular_velocity(a3, l, i)) * a3;
+    glm::dmat3 a4 = glm::orthonormalize(a + k3);
+    glm::dmat3 k4 = dt * Integrator::star(angular_velocity(a4, l, i)) * a4;
+
+    return glm::orthonormalize(a + (1. / 6.) * k1 + (1. / 3.) * k2 + (1. / 3.) * k3 + (1. / 6.) * k4);
+}
+
+/** One torque free fourth order Runge Kutta step of unit quaternion {q}, normalized at every stage. */
+static glm::dquat step_quaternion(const glm::dquat &q, glm::dvec3 l, const glm::dmat3 &i, double dt)
+{
+    glm::dquat k1 = dt * Integrator::spin(angular_velocity(glm::mat3_cast(q), l, i), q);
+    glm::dquat q2 = glm::normalize(q + .5 * k1);
+    glm::dquat k2 = dt * Integrator::spin(angular_velocity(glm::mat3_cast(q2), l, i), q2);
+    glm::dquat q3 = glm::normalize(q + .5 * k2);
+    glm::dquat k3 = dt * Integrator::spin(angular_velocity(glm::mat3_cast(q3), l, i), q3);
+    glm::dquat q4 = glm::normalize(q + k3);
+    glm::dquat k4 = dt * Integrator::spin(angular_velocity(glm::mat3_cast(q4), l, i), q4);
+
+    return glm::normalize(q + (1. / 6.) * k1 + (1. / 3.) * k2 + (1. / 3.) * k3 + (1. / 6.) * k4);
+}
+
+/** Angle in radians of the rotation between unit quaternions {p} and {q}. */
+static double angle_between(const glm::dquat &p, const glm::dquat &q)
+{
+    return 2. * std::acos(std::min(1., std::abs(glm::dot(p, q))));
+}
+
+/** Relative change of the rotational kinetic energy of orientation {a} against {a_0}. */
+static double energy_drift(const glm::dmat3 &a, const glm::dmat3 &a_0, glm::dvec3 l, const glm::dmat3 &i)
+{
+    double e_0 = glm::dot(l, angular_velocity(a_0, l, i));
+    return std::abs(glm::dot(l, angular_velocity(a, l, i)) - e_0) / e_0;
+}
+
+/**
+ * Integrates the orientation of {COUNT} torque free spinning boxes with distinct moments of inertia for {STEPS}
+ * steps, stored as rotation matrix and as unit quaternion. The error is the largest angle to a quaternion solution
+ * with {REFERENCE_SUBSTEPS} times smaller steps, the drift is the largest relative change in kinetic energy. */
+void orientation_benchmark()
+{
+    const uint32_t COUNT = 10000;
+    const uint32_t STEPS = 120;
+    const uint32_t REFERENCE_SUBSTEPS = 64;
+    const double DT = 1. / 60.;
+
+    std::srand(1);
+    Box box(1., 1., 2., 3.);
+    glm::dmat3 i = box.get_inv_moment_of_inertia();
+    std::vector<glm::dmat3> a;
+    std::vector<glm::dquat> q;
+    std::vector<glm::dvec3> l;
+    for (uint32_t j = 0; j < COUNT; j++) {
+        glm::dvec3 axis = glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit()));
+        q.emplace_back(glm::angleAxis(M_PI * random_unit(), axis));
+        a.emplace_back(glm::mat3_cast(q.back()));
+        l.emplace_back(10. * random_unit(), 10. * random_unit(), 10. * random_unit());
+    }
+    std::vector<glm::dmat3> a_0 = a;
+    std::vector<glm::dquat> reference = q;
+
+    Timer timer;
+    for (uint32_t step = 0; step < STEPS; step++) {
+        for (uint32_t j = 0; j < COUNT; j++) {
+            a[j] = step_matrix(a[j], l[j], i, DT);
+        }
+    }
+    double matrix_ms = timer.get_ms();
+
+    timer.reset();
+    for (uint32_t step = 0; step < STEPS; step++) {
+        for (uint32_t j = 0; j < COUNT; j++) {
+            q[j] = step_quaternion(q[j], l[j], i, DT);
+        }
+    }
+    double quaternion_ms = timer.get_ms();
+
+    for (uint32_t step = 0; step < STEPS * REFERENCE_SUBSTEPS; step++) {
+        for (uint32_t j = 0; j < COUNT; j++) {
+            reference[j] = step_quaternion(reference[j], l[j], i, DT / REFERENCE_SUBSTEPS);
+        }
+    }
+
+    double matrix_error = 0., quaternion_error = 0., matrix_drift = 0., quaternion_drift = 0.;
+    for (uint32_t j = 0; j < COUNT; j++) {
+        matrix_error = std::max(matrix_error, angle_between(glm::normalize(glm::quat_cast(a[j])), reference[j]));
+        quaternion_error = std::max(quaternion_error, angle_between(q[j], reference[j]));
+        matrix_drift = std::max(matrix_drift, energy_drift(a[j], a_0[j], l[j], i));
+        quaternion_drift = std::max(quaternion_drift, energy_drift(glm::mat3_cast(q[j]), a_0[j], l[j], i));
+    }
+
+    double body_steps = (double) COUNT * STEPS;
+    printf("%-12s %8s %12s %12s %12s\n", "orientation", "bytes", "ns/step", "max error", "max drift");
+    printf("%-12s %8zu %12.1f %12.3e %12.3e\n", "matrix", sizeof(glm::dmat3), 1e6 * matrix_ms / body_steps,
+           matrix_error, matrix_drift);
+    printf("%-12s %8zu %12.1f %12.3e %12.3e\n", "quaternion", sizeof(glm::dquat), 1e6 * quaternion_ms / body_steps,
+           quaternion_error, quaternion_drift);
+}
@@ -0,0 +1,82 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/plane_kernel.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Classification of the vertices of {body} one {glm::dvec3} at a time, as done before {PlaneKernel}. */
+static int32_t which_side_scalar(RigidBody *body, glm::dvec3 translation, glm::dvec3 p, glm::dvec3 n)
+{
+    uint32_t positive = 0;
+    uint32_t negative = 0;
+    for (auto &vertex : body->get_world_space_vertices()) {
+        glm::dvec3 v = vertex + translation;
+        double t = glm::dot(n, v - p);
+        if (t > 0) positive++; else if (t < 0) negative++;
+        if (positive && negative) return 0;
+    }
+
+    if (positive) {
+        return +1;
+    } else {
+        return -1;
+    }
+}
+
+/**
+ * Classifies the vertices of {shape} against {count} random planes which do not intersect it, such that every
+ * vertex is classified, one vertex at a time and with {PlaneKernel}. */
+static void run(const char *name, const ShapeWithMass *shape, uint32_t count)
+{
+    std::srand(1);
+    RigidBody body(glm::dvec3(0.), glm::dmat3(glm::rotate(glm::identity<glm::dmat4>(), 1., glm::dvec3(0., 0., 1.))),
+                   shape);
+    glm::dvec3 translation(.01, .02, .03);
+
+    std::vector<glm::dvec3> normals;
+    for (uint32_t i = 0; i < count; i++) {
+        normals.emplace_back(glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit())));
+    }
+
+    int32_t scalar_sum = 0;
+    Timer timer;
+    for (auto &n : normals) {
+        scalar_sum += which_side_scalar(&body, translation, 2. * n, n);
+    }
+    double scalar_ms = timer.get_ms();
+
+    int32_t kernel_sum = 0;
+    timer.reset();
+    for (auto &n : normals) {
+        kernel_sum += PlaneKernel::which_side(body.get_world_space_vertex_arrays(), translation, 2. * n, n, 0.);
+    }
+    double kernel_ms = timer.get_ms();
+
+    // vertices classified per second, in millions, the sums agree if both classify alike
+    double vertices = (double) count * body.get_world_space_vertices().size();
+    printf("%-16s %10d %10d %12.1f %12.1f\n", name, scalar_sum, kernel_sum,
+           1e-3 * vertices / scalar_ms, 1e-3 * vertices / kernel_ms);
+}
+
+void plane_kernel_benchmark()
+{
+    const uint32_t COUNT = 1000000;
+    Box cube(1., 1., 1., 1.);
+    Icosahedron icosahedron(1., 1., 1., 1.);
+
+    printf("%-16s %10s %10s %12s %12s\n", "shape", "scalar", "kernel", "Mv/s scalar", "Mv/s kernel");
+    run("cube", &cube, COUNT);
+    run("icosahedron", &icosahedron, COUNT);
+
+    // around {SUPPORT_MIN_VERTICES} vertices, where {Collision::intersect} switches to {RigidBody::support}
+    Shape small_shape = create_sphere(4, 8);
+    Sphere small_sphere(1., 1., &small_shape);
+    run("sphere 34", &small_sphere, COUNT / 4);
+    Shape large_shape = create_sphere(8, 16);
+    Sphere large_sphere(1., 1., &large_shape);
+    run("sphere 130", &large_sphere, COUNT / 16);
+}
@@ -0,0 +1,160 @@
+#include "bench.hpp"
+#include "simulation/math.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Solves A_CC * x = -A_Cd by factorizing A_CC from scratch, as done before {math::LdltFactor}. */
+static void fdirection_refactor(double *fvec_delta, const double *amat, const bool *c, uint32_t n, uint32_t d)
+{
+    memset(fvec_delta, 0., n * sizeof(double));
+    fvec_delta[d] = 1.;
+
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < n; i++) {
+        if (c[i]) indices.emplace_back(i);
+    }
+    uint32_t m = indices.size();
+    if (m == 0) return;
+
+    std::vector<double> amat_11(m * m);
+    std::vector<double> vvec_1(m);
+    std::vector<double> x(m);
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < m; j++) {
+            amat_11[i * m + j] = amat[indices[i] * n + indices[j]];
+        }
+        vvec_1[i] = -amat[indices[i] * n + d];
+    }
+    math::lp_solve(amat_11.data(), x.data(), vvec_1.data(), m);
+
+    for (uint32_t i = 0; i < m; i++) {
+        fvec_delta[indices[i]] = x[i];
+    }
+}
+
+/** {math::qp_solve} from a zero guess, with {fdirection_refactor}. Returns the number of pivots. */
+static uint32_t qp_solve_refactor(const double *amat, const double *bvec, double *fvec, uint32_t n)
+{
+    std::vector<double> avec(bvec, bvec + n);
+    std::vector<double> fvec_delta(n);
+    std::vector<double> avec_delta(n);
+    auto c = (bool *) calloc(n, sizeof(bool));
+    auto nc = (bool *) calloc(n, sizeof(bool));
+    memset(fvec, 0., n * sizeof(double));
+
+    uint32_t pivots = 0;
+    for (uint32_t d = 0; d < n; d++) {
+        if (avec[d] >= -1.e-14) continue;
+
+        while (true) {
+            pivots++;
+            fdirection_refactor(fvec_delta.data(), amat, c, n, d);
+            math::mat_mul_vec(avec_delta.data(), amat, fvec_delta.data(), n);
+
+            double s;
+            uint32_t j;
+            math::maxstep(&s, &j, fvec, avec.data(), fvec_delta.data(), avec_delta.data(), c, nc, n, d);
+            for (uint32_t i = 0; i < n; i++) {
+                fvec[i] += s * fvec_delta[i];
+                avec[i] += s * avec_delta[i];
+            }
+
+            if (c[j]) {
+                c[j] = false;
+                nc[j] = true;
+            } else if (nc[j]) {
+                nc[j] = false;
+                c[j] = true;
+            } else {
+                c[j] = true;
+                break;
+            }
+        }
+
+        // start over, as in {math::qp_solve}
+        d = (uint32_t) -1;
+    }
+
+    free(nc);
+    free(c);
+
+    return pivots;
+}
+
+/** Solves {count} random problems of size {n}, of which A is symmetric positive definite and b is in [-1, 1]. */
+static void run(uint32_t n, uint32_t count)
+{
+    std::srand(n);
+
+    double refactor_ms = 0.;
+    double incremental_ms = 0.;
+    uint32_t refactor_pivots = 0;
+    uint32_t incremental_pivots = 0;
+    double difference = 0.;
+    math::SolverWorkspace workspace;
+    for (uint32_t k = 0; k < count; k++) {
+        // A = G * G^T / n + I / 10
+        std::vector<double> g(n * n);
+        for (auto &value : g) {
+            value = random_unit();
+        }
+        std::vector<double> amat(n * n);
+        for (uint32_t i = 0; i < n; i++) {
+            for (uint32_t j = 0; j < n; j++) {
+                double sum = i == j ? .1 : 0.;
+                for (uint32_t l = 0; l < n; l++) {
+                    sum += g[i * n + l] * g[j * n + l] / n;
+                }
+                amat[i * n + j] = sum;
+            }
+        }
+        std::vector<double> bvec(n);
+        for (auto &value : bvec) {
+            value = random_unit();
+        }
+
+        math::SparseMatrix sparse;
+        sparse.n = n;
+        sparse.row_start.emplace_back(0);
+        for (uint32_t i = 0; i < n; i++) {
+            for (uint32_t j = 0; j < n; j++) {
+                sparse.columns.emplace_back(j);
+                sparse.values.emplace_back(amat[i * n + j]);
+            }
+            sparse.row_start.emplace_back(sparse.columns.size());
+        }
+
+        std::vector<double> refactor_fvec(n);
+        Timer timer;
+        refactor_pivots += qp_solve_refactor(amat.data(), bvec.data(), refactor_fvec.data(), n);
+        refactor_ms += timer.get_ms();
+
+        std::vector<double> fvec(n, 0.);
+        timer.reset();
+        incremental_pivots += math::qp_solve(sparse, bvec.data(), fvec.data(), n, &workspace);
+        incremental_ms += timer.get_ms();
+
+        for (uint32_t i = 0; i < n; i++) {
+            difference = std::max(difference, std::abs(fvec[i] - refactor_fvec[i]));
+        }
+    }
+
+    printf("%6u %10.1f %10.1f %12.3f %12.3f %12.3f %12.3f %10.1e\n", n, (double) refactor_pivots / count,
+           (double) incremental_pivots / count, refactor_ms / count, incremental_ms / count,
+           1e3 * refactor_ms / refactor_pivots, 1e3 * incremental_ms / incremental_pivots, difference);
+}
+
+void qp_solve_benchmark()
+{
+    printf("%6s %10s %10s %12s %12s %12s %12s %10s\n", "n", "pivots", "pivots", "ms refactor", "ms update",
+           "us/pivot", "us/pivot", "max |df|");
+    run(10, 100);
+    run(50, 20);
+    run(100, 5);
+    run(200, 2);
+    run(500, 1);
+}
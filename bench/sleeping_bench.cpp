@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/**
+ * Steps 500 cubes resting apart on a table {settle_steps} times, then measures {steps} more steps, with or without
+ * sleeping. Returns the time per measured step in milliseconds and stores the number of sleeping bodies. */
+static double run(bool sleeping, uint32_t settle_steps, uint32_t steps, uint32_t *asleep)
+{
+    Engine engine;
+    engine.threads = 1;
+    engine.sleeping = sleeping;
+    engine.change_scene(new PilesScene(25, 20, 1));
+    engine.run = true;
+    for (uint32_t i = 0; i < settle_steps; i++) {
+        engine.update();
+    }
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms() / steps;
+
+    *asleep = 0;
+    for (auto &body : engine.body_system->bodies) {
+        if (body.asleep) (*asleep)++;
+    }
+
+    return ms;
+}
+
+void sleeping_benchmark()
+{
+    // {BodySystem::sleep_time} is half a second, or 30 steps
+    const uint32_t SETTLE_STEPS = 60;
+    const uint32_t STEPS = 30;
+
+    printf("%10s %10s %10s\n", "sleeping", "asleep", "ms/step");
+    for (bool sleeping : {false, true}) {
+        uint32_t asleep;
+        double ms = run(sleeping, SETTLE_STEPS, STEPS, &asleep);
+        printf("%10s %10u %10.3f\n", sleeping ? "yes" : "no", asleep, ms);
+    }
+}
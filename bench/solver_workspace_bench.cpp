@@ -0,0 +1,71 @@
+#include <cinttypes>
+#include <cstdlib>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/**
+ * Steps {PilesScene} without warm starting, such that every step pivots, and counts the allocations of the contact
+ * force solver. The islands of the last step are then solved twice with a new workspace, which grows in the first
+ * pass only. The allocations of the steps themselves are reported for comparison. Exits with a failure if the
+ * workspace grows after the warm-up steps, or if the second pass allocates. */
+void solver_workspace_benchmark()
+{
+    const uint32_t WARM_UP_STEPS = 3;
+    const uint32_t STEPS = 10;
+
+    Engine engine;
+    engine.warm_start = false;
+    engine.sleeping = false;
+    engine.threads = 1;
+    engine.change_scene(new PilesScene(4, 4, 2));
+    engine.run = true;
+    for (uint32_t i = 0; i < WARM_UP_STEPS; i++) {
+        engine.update();
+    }
+
+    math::SolverWorkspace &engine_workspace = engine.body_system->solver_workspaces[0];
+    uint64_t growths = engine_workspace.allocations;
+    uint64_t allocations = allocation_count;
+    for (uint32_t i = 0; i < STEPS; i++) {
+        engine.update();
+    }
+    double step_allocations = (double) (allocation_count - allocations) / STEPS;
+    uint64_t step_growths = engine_workspace.allocations - growths;
+
+    // solve the islands of the current contacts in isolation, from a zero guess
+    std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(engine.body_system);
+    Integrator::apply_forces(engine.body_system);
+    math::SolverWorkspace workspace;
+    std::vector<std::vector<Contact *>> islands = Island::find_islands(contacts, engine.body_system->bodies);
+    uint64_t pivots = 0;
+    uint64_t solver_allocations = 0;
+    uint64_t solver_growths = 0;
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        allocations = allocation_count;
+        growths = workspace.allocations;
+        for (auto &island : islands) {
+            for (auto &contact : island) {
+                contact->force = 0.;
+            }
+            pivots += CollisionHandling::solve_contact_forces(engine.body_system, island, &workspace);
+        }
+        solver_allocations = allocation_count - allocations;
+        solver_growths = workspace.allocations - growths;
+        printf("pass %u: %zu islands, %" PRIu64 " pivots, %" PRIu64 " allocations in the solver, %" PRIu64
+               " workspace growths\n", pass, islands.size(), pivots, solver_allocations, solver_growths);
+        pivots = 0;
+    }
+
+    printf("steps: %.1f allocations per step, %" PRIu64 " workspace growths after %u steps\n",
+           step_allocations, step_growths, WARM_UP_STEPS);
+
+    for (auto &contact : contacts) {
+        delete contact;
+    }
+
+    if (step_growths != 0 || solver_allocations != 0 || solver_growths != 0) {
+        printf("FAILED: the contact force solver allocates once its workspace has grown\n");
+        exit(EXIT_FAILURE);
+    }
+}
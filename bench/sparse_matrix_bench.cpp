@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** Assembles the contact matrix of {count_x} by {count_z} cubes resting on a table, dense and sparse. */
+static void run(uint32_t count_x, uint32_t count_z, uint32_t repetitions)
+{
+    Engine engine;
+    engine.change_scene(new PilesScene(count_x, count_z, 1));
+    std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(engine.body_system);
+
+    auto amat = (double *) malloc(contacts.size() * contacts.size() * sizeof(double));
+    Timer timer;
+    for (uint32_t i = 0; i < repetitions; i++) {
+        CollisionHandling::compute_a_matrix(amat, contacts);
+    }
+    double dense_ms = timer.get_ms();
+
+    math::SparseMatrix sparse;
+    math::SolverWorkspace workspace;
+    timer.reset();
+    for (uint32_t i = 0; i < repetitions; i++) {
+        CollisionHandling::compute_a_matrix(&sparse, contacts, &workspace);
+    }
+    double sparse_ms = timer.get_ms();
+
+    // the stored entries equal the dense matrix, and all others are zero there
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < contacts.size(); i++) {
+        for (uint32_t j = 0; j < contacts.size(); j++) {
+            if (sparse.get(i, j) != amat[i * contacts.size() + j]) mismatches++;
+        }
+    }
+
+    printf("%6u %9zu %9zu %12.3f %12.3f %10u\n", count_x * count_z, contacts.size(), sparse.values.size(),
+           dense_ms / repetitions, sparse_ms / repetitions, mismatches);
+
+    free(amat);
+    for (auto &contact : contacts) {
+        delete contact;
+    }
+}
+
+void sparse_matrix_benchmark()
+{
+    printf("%6s %9s %9s %12s %12s %10s\n", "cubes", "contacts", "nonzeros", "ms/dense", "ms/sparse", "mismatches");
+    run(5, 5, 20);
+    run(5, 10, 20);
+    run(10, 10, 10);
+    run(10, 20, 5);
+    run(20, 20, 2);
+}
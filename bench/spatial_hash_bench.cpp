@@ -0,0 +1,45 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** Runs {CollisionDetection::find_all_contacts} {iterations} times while the cubes of {scene} fall. */
+static void run(const char *name, Scene *scene, BroadphaseType type, uint32_t iterations)
+{
+    std::srand(1);
+    BodySystem *body_system = scene->initialize();
+    body_system->set_broadphase(Broadphase::create(type, Engine::DISTANCE_THRESHOLD));
+
+    uint64_t pair_tests = 0;
+    uint64_t contact_count = 0;
+    Timer timer;
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (auto &body : body_system->bodies) {
+            if (body.shape->get_inv_mass() == 0.) continue;
+            // fall until the lowest corner rests on the surface
+            body.x.y -= std::min(.05, Aabb(&body, 0.).min.y);
+        }
+        std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(body_system);
+        pair_tests += body_system->broadphase->get_pairs().size();
+        contact_count += contacts.size();
+        for (auto &contact : contacts) {
+            delete contact;
+        }
+    }
+    double ms = timer.get_ms();
+
+    printf("%-16s %8zu %14.1f %10.1f %12.4f\n",
+           name, body_system->bodies.size(), (double) pair_tests / iterations,
+           (double) contact_count / iterations, ms / iterations);
+
+    delete body_system;
+}
+
+void spatial_hash_benchmark()
+{
+    // the cubes come to rest on the surface halfway
+    const uint32_t ITERATIONS = 40;
+
+    printf("%-16s %8s %14s %10s %12s\n", "broadphase", "bodies", "pair tests", "contacts", "ms/step");
+    DiceGridScene scene(32, 32, 1);
+    run("all pairs", &scene, ALL_PAIRS, ITERATIONS);
+    run("spatial hash", &scene, SPATIAL_HASH, ITERATIONS);
+}
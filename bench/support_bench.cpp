@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/**
+ * Finds the extreme vertices along random directions of a sphere with {rings} rings of {segments} vertices, by
+ * iterating all vertices and by {RigidBody::support}, and tests random pairs with {Collision::intersect}. */
+static void run(uint32_t rings, uint32_t segments)
+{
+    const uint32_t DIRECTIONS = 100000;
+    const uint32_t PAIRS = 20;
+
+    std::srand(1);
+    Shape shape = create_sphere(rings, segments);
+    Sphere sphere(1., 1., &shape);
+    RigidBody body(glm::dvec3(0.), glm::dmat3(glm::rotate(glm::identity<glm::dmat4>(), 1., glm::dvec3(0., 0., 1.))),
+                   &sphere);
+    const std::vector<glm::dvec3> &vertices = body.get_world_space_vertices();
+
+    std::vector<glm::dvec3> directions;
+    for (uint32_t i = 0; i < DIRECTIONS; i++) {
+        directions.emplace_back(glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit())));
+    }
+
+    // the extent along every direction, as needed to classify a plane
+    double scan_sum = 0.;
+    Timer timer;
+    for (auto &n : directions) {
+        double min = DBL_MAX;
+        double max = -DBL_MAX;
+        for (auto &v : vertices) {
+            min = std::min(min, glm::dot(n, v));
+            max = std::max(max, glm::dot(n, v));
+        }
+        scan_sum += max - min;
+    }
+    double scan_ms = timer.get_ms();
+
+    double support_sum = 0.;
+    timer.reset();
+    for (auto &n : directions) {
+        support_sum += glm::dot(n, vertices[body.support(n)]) - glm::dot(n, vertices[body.support(-n)]);
+    }
+    double support_ms = timer.get_ms();
+
+    // pairs around touching distance, such that many planes need to be classified
+    std::vector<RigidBody> bodies;
+    for (uint32_t i = 0; i < PAIRS; i++) {
+        glm::dvec3 axis = glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit()));
+        bodies.emplace_back(glm::dvec3(0.), &sphere);
+        glm::dmat3 a(glm::rotate(glm::identity<glm::dmat4>(), random_unit(), axis));
+        bodies.emplace_back(axis * (.98 + .04 * (double) std::rand() / RAND_MAX), a, &sphere);
+    }
+
+    uint32_t separated = 0;
+    timer.reset();
+    for (uint32_t i = 0; i < PAIRS; i++) {
+        if (!Collision::intersect(&bodies[2 * i], &bodies[2 * i + 1], 0.).intersect) separated++;
+    }
+    double intersect_ms = timer.get_ms();
+
+    // the sums agree if the walk finds the furthest vertices
+    printf("%8u %8zu %10.3f %10.3f %10.6f %10u %10.3f\n", rings, vertices.size(),
+           1e3 * scan_ms / DIRECTIONS, 1e3 * support_ms / DIRECTIONS, std::abs(scan_sum - support_sum),
+           separated, intersect_ms / PAIRS);
+}
+
+void support_benchmark()
+{
+    printf("%8s %8s %10s %10s %10s %10s %10s\n",
+           "rings", "vertices", "us/scan", "us/support", "error", "separated", "ms/pair");
+    run(4, 8);
+    run(8, 16);
+    run(16, 32);
+    run(32, 64);
+}
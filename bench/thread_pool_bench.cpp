@@ -0,0 +1,79 @@
+#include <cstring>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/thread_pool.hpp"
+
+/**
+ * Steps 64 piles of {pile_size} by {pile_size} cubes {steps} times on {threads} threads and stores the positions of
+ * the bodies in {positions}. Returns the time per step in milliseconds, and in {solve_ms} the time of solving the
+ * contact forces of the last step alone, which is the part that runs on multiple threads. */
+static double run(
+        uint32_t pile_size, uint32_t threads, uint32_t steps, std::vector<glm::dvec3> *positions, double *solve_ms)
+{
+    const uint32_t SOLVES = 10;
+
+    Engine engine;
+    engine.warm_start = false;
+    engine.sleeping = false;
+    engine.threads = threads;
+    engine.change_scene(new PilesScene(8, 8, pile_size));
+    engine.run = true;
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms();
+
+    positions->clear();
+    for (auto &body : engine.body_system->bodies) {
+        positions->emplace_back(body.x);
+    }
+
+    // solve the contacts of the current state from scratch, as at every step
+    std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(engine.body_system);
+    timer.reset();
+    for (uint32_t i = 0; i < SOLVES; i++) {
+        for (auto &contact : contacts) {
+            contact->force = 0.;
+        }
+        Integrator::apply_forces(engine.body_system);
+        CollisionHandling::compute_contact_forces(engine.body_system, contacts);
+    }
+    *solve_ms = timer.get_ms() / SOLVES;
+
+    for (auto &contact : contacts) {
+        delete contact;
+    }
+
+    return ms / steps;
+}
+
+void thread_pool_benchmark()
+{
+    // without warm starting, such that every step solves from scratch
+    const uint32_t STEPS = 10;
+
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    // the speedups are relative to one thread, of the whole step and of solving the contact forces alone
+    printf("%6s %8s %10s %10s %10s %10s %10s\n", "pile", "threads", "ms/step", "speedup", "ms/solve", "speedup",
+           "identical");
+    for (uint32_t pile_size : {2, 3}) {
+        std::vector<glm::dvec3> serial;
+        double serial_solve_ms;
+        double serial_ms = run(pile_size, 1, STEPS, &serial, &serial_solve_ms);
+        printf("%6u %8u %10.3f %10.2f %10.3f %10.2f %10s\n", pile_size, 1, serial_ms, 1., serial_solve_ms, 1., "yes");
+        for (uint32_t threads : {2, 4, 8}) {
+            std::vector<glm::dvec3> parallel;
+            double solve_ms;
+            double ms = run(pile_size, threads, STEPS, &parallel, &solve_ms);
+
+            // the positions are compared bitwise, as the forces are applied in the same order
+            bool identical = serial.size() == parallel.size() &&
+                             memcmp(serial.data(), parallel.data(), serial.size() * sizeof(glm::dvec3)) == 0;
+            printf("%6u %8u %10.3f %10.2f %10.3f %10.2f %10s\n", pile_size, threads, ms, serial_ms / ms, solve_ms,
+                   serial_solve_ms / solve_ms, identical ? "yes" : "no");
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+
+/**
+ * Steps {count} by {count} randomly oriented cubes in two layers, thrown onto a table with downward velocity
+ * {speed}, for {steps} steps, finding the time of collision by conservative advancement or by bisection. Returns
+ * the time per step in milliseconds and stores the number of searches of the time of collision and the number of
+ * times all bodies were integrated again for them. */
+static double run(bool conservative_advancement, uint32_t count, double speed, uint32_t steps, uint64_t *impacts,
+                  uint64_t *repeated_integrations)
+{
+    std::srand(1);
+    Engine engine;
+    engine.threads = 1;
+    engine.conservative_advancement = conservative_advancement;
+    engine.localized_substeps = false;
+    engine.change_scene(new DiceGridScene(count, count, 2));
+    engine.run = true;
+    for (auto &body : engine.body_system->bodies) {
+        if (body.shape->get_inv_mass() == 0.) continue;
+
+        body.p = glm::dvec3(0., -speed / body.shape->get_inv_mass(), 0.);
+    }
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms() / steps;
+
+    *impacts = engine.impacts;
+    *repeated_integrations = engine.repeated_integrations;
+
+    return ms;
+}
+
+void time_of_impact_benchmark()
+{
+    // the upper layer lands after about 40 steps if dropped, the faster cubes move at most a quarter of the table
+    // thickness per step, such that they cannot pass through it
+    const uint32_t STEPS = 60;
+
+    printf("%8s %8s %8s %10s %12s %10s\n", "bodies", "speed", "method", "impacts", "integrated", "ms/step");
+    for (uint32_t count : {4, 8}) {
+        for (double speed : {0., 15.}) {
+            for (bool conservative_advancement : {false, true}) {
+                uint64_t impacts, repeated_integrations;
+                double ms = run(conservative_advancement, count, speed, STEPS, &impacts, &repeated_integrations);
+                printf("%8u %8.1f %8s %10lu %12lu %10.3f\n", 2 * count * count, speed,
+                       conservative_advancement ? "advance" : "bisect", (unsigned long) impacts,
+                       (unsigned long) repeated_integrations, ms);
+            }
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#include <cinttypes>
+
+#include "bench.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/contact_manifold_cache.hpp"
+
+/** Steps {StableScene}, in which cubes rest on a surface, {steps} times. */
+static void run(const char *name, bool warm_start, uint32_t steps)
+{
+    Engine engine;
+    engine.warm_start = warm_start;
+    engine.sleeping = false;
+    engine.change_scene(new StableScene());
+    engine.run = true;
+
+    Timer timer;
+    for (uint32_t i = 0; i < steps; i++) {
+        engine.update();
+    }
+    double ms = timer.get_ms();
+
+    printf("%-12s %12.2f %12" PRIu64 " %12" PRIu64 " %10.3f\n", name, (double) engine.pivots / steps,
+           engine.body_system->manifold_cache->get_hits(), engine.body_system->manifold_cache->get_misses(),
+           ms / steps);
+}
+
+void warm_start_benchmark()
+{
+    // without warm starting, the scene runs into a degenerate pivot after some more steps
+    const uint32_t STEPS = 30;
+
+    printf("%-12s %12s %12s %12s %10s\n", "solver", "pivots/step", "matched", "unmatched", "ms/step");
+    run("cold", false, STEPS);
+    run("warm", true, STEPS);
+}
@@ -5,8 +5,32 @@ Shape::Shape(
         std::vector<std::pair<uint32_t, uint32_t>> p_edges,
         std::vector<std::vector<std::pair<uint32_t, glm::vec2>>> p_faces
 ) :
-        vertices(std::move(p_vertices)), edges(std::move(p_edges)), faces(std::move(p_faces))
-{}
+        vertices(std::move(p_vertices)), edges(std::move(p_edges)), faces(std::move(p_faces)),
+        vertex_adjacency(vertices.size()), vertex_edges(vertices.size())
+{
+    for (uint32_t k = 0; k < edges.size(); k++) {
+        const std::pair<uint32_t, uint32_t> &edge = edges[k];
+        // find the faces which have the endpoints of the edge as consecutive vertices
+        std::vector<uint32_t> adjacent;
+        for (uint32_t i = 0; i < faces.size(); i++) {
+            for (uint32_t j = 0; j < faces[i].size(); j++) {
+                uint32_t v1 = faces[i][j].first;
+                uint32_t v2 = faces[i][(j + 1) % faces[i].size()].first;
+                if ((v1 == edge.first && v2 == edge.second) || (v1 == edge.second && v2 == edge.first)) {
+                    adjacent.emplace_back(i);
+                }
+            }
+        }
+        // every edge of a closed polyhedron is shared by exactly two faces
+        assert(adjacent.size() == 2);
+        edge_faces.emplace_back(adjacent[0], adjacent[1]);
+
+        vertex_adjacency[edge.first].emplace_back(edge.second);
+        vertex_adjacency[edge.second].emplace_back(edge.first);
+        vertex_edges[edge.first].emplace_back(k);
+        vertex_edges[edge.second].emplace_back(k);
+    }
+}
 
 const std::vector<glm::dvec3> &Shape::get_vertices() const
 {
@@ -23,6 +47,27 @@ const std::vector<std::vector<std::pair<uint32_t, glm::vec2>>> &Shape::get_faces
     return faces;
 }
 
+const std::vector<std::pair<uint32_t, uint32_t>> &Shape::get_edge_faces() const
+{
+    return edge_faces;
+}
+
+const std::vector<std::vector<uint32_t>> &Shape::get_vertex_adjacency() const
+{
+    return vertex_adjacency;
+}
+
+uint32_t Shape::find_edge(uint32_t v1, uint32_t v2) const
+{
+    if (v1 >= vertices.size()) return UINT32_MAX;
+
+    for (uint32_t i = 0; i < vertex_adjacency[v1].size(); i++) {
+        if (vertex_adjacency[v1][i] == v2) return vertex_edges[v1][i];
+    }
+
+    return UINT32_MAX;
+}
+
 glm::dvec3 Shape::get_non_unit_normal(uint32_t face_i) const
 {
     glm::dvec3 v1 = vertices[faces[face_i][0].first]; // first  point on face
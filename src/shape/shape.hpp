@@ -2,7 +2,9 @@
 #define SHAPE_SHAPE_HPP
 
 #include <vector>
+#include <cassert>
 #include <utility>
+#include <cstdint>
 
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
@@ -25,6 +27,17 @@ private:
      * The faces are in no particular order, but a singular face must be defined in counter-clockwise orientation from
      * outside of the shape (this is to calculate normal and facilitate OpenGL culling). */
     std::vector<std::vector<std::pair<uint32_t, glm::vec2>>> faces;
+
+    /**
+     * For every edge in {edges}, the indices of the two faces it is adjacent to, inferred from {faces}. On the
+     * Gauss map, the normals of these faces are the endpoints of the arc of the edge. */
+    std::vector<std::pair<uint32_t, uint32_t>> edge_faces;
+
+    /** For every vertex in {vertices}, the indices of the vertices it shares an edge with, inferred from {edges}. */
+    std::vector<std::vector<uint32_t>> vertex_adjacency;
+
+    /** For every vertex in {vertices}, the indices to {edges} of the edges in {vertex_adjacency}. */
+    std::vector<std::vector<uint32_t>> vertex_edges;
 public:
     Shape(
             std::vector<glm::dvec3> p_vertices,
@@ -38,6 +51,13 @@ public:
 
     const std::vector<std::vector<std::pair<uint32_t, glm::vec2>>> &get_faces() const;
 
+    const std::vector<std::pair<uint32_t, uint32_t>> &get_edge_faces() const;
+
+    const std::vector<std::vector<uint32_t>> &get_vertex_adjacency() const;
+
+    /** Index to {edges} of the edge between vertices {v1} and {v2}, or UINT32_MAX if they share no edge. */
+    uint32_t find_edge(uint32_t v1, uint32_t v2) const;
+
     /** Normal pointing outwards. */
     glm::dvec3 get_non_unit_normal(uint32_t face_i) const;
 
@@ -0,0 +1,115 @@
+#include "body_state.hpp"
+#include "rigid_body.hpp"
+
+uint32_t BodyState::size() const
+{
+    return x.size();
+}
+
+void BodyState::resize(uint32_t n)
+{
+    index.resize(n);
+    x.resize(n);
+    p.resize(n);
+    q.resize(n);
+    l.resize(n);
+    v.resize(n);
+    i_inv.resize(n);
+    omega.resize(n);
+    force.resize(n);
+    torque.resize(n);
+    inv_mass.resize(n);
+    inv_moment_of_inertia.resize(n);
+    for (auto *scratch : {&x_0, &p_0, &l_0, &v_0, &omega_0, &x_sum, &p_sum, &l_sum, &x_delta, &p_delta, &l_delta}) {
+        scratch->resize(n);
+    }
+    for (auto *scratch : {&q_0, &q_sum, &q_delta}) {
+        scratch->resize(n);
+    }
+}
+
+void BodyState::load(const std::vector<RigidBody> &bodies)
+{
+    index.clear();
+    slot.assign(bodies.size(), -1);
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        if (bodies[i].asleep || bodies[i].finished) continue;
+
+        slot[i] = (int32_t) index.size();
+        index.emplace_back(i);
+    }
+
+    uint32_t n = index.size();
+    resize(n);
+    for (uint32_t i = 0; i < n; i++) {
+        const RigidBody &body = bodies[index[i]];
+        x[i] = body.x;
+        p[i] = body.p;
+        q[i] = body.q;
+        l[i] = body.l;
+        v[i] = body.v;
+        i_inv[i] = body.i_inv;
+        omega[i] = body.omega;
+        force[i] = glm::dvec3(0.);
+        torque[i] = glm::dvec3(0.);
+        inv_mass[i] = body.shape->get_inv_mass();
+        inv_moment_of_inertia[i] = body.shape->get_inv_moment_of_inertia();
+    }
+}
+
+void BodyState::remove_finished(const std::vector<RigidBody> &bodies)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < size(); i++) {
+        if (bodies[index[i]].finished) {
+            slot[index[i]] = -1;
+            continue;
+        }
+
+        slot[index[i]] = (int32_t) n;
+        index[n] = index[i];
+        for (auto *quantity : {&x, &p, &l, &v, &omega, &force, &torque, &x_0, &p_0, &l_0, &v_0, &omega_0, &x_sum,
+                               &p_sum, &l_sum, &x_delta, &p_delta, &l_delta}) {
+            (*quantity)[n] = (*quantity)[i];
+        }
+        for (auto *quantity : {&q, &q_0, &q_sum, &q_delta}) {
+            (*quantity)[n] = (*quantity)[i];
+        }
+        i_inv[n] = i_inv[i];
+        inv_mass[n] = inv_mass[i];
+        inv_moment_of_inertia[n] = inv_moment_of_inertia[i];
+        n++;
+    }
+
+    resize(n);
+}
+
+void BodyState::store_state(std::vector<RigidBody> *bodies) const
+{
+    for (uint32_t i = 0; i < size(); i++) {
+        RigidBody &body = (*bodies)[index[i]];
+        body.x = x[i];
+        body.p = p[i];
+        body.q = q[i];
+        body.l = l[i];
+        body.v = v[i];
+        body.i_inv = i_inv[i];
+        body.omega = omega[i];
+    }
+}
+
+void BodyState::store_forces(std::vector<RigidBody> *bodies) const
+{
+    for (uint32_t i = 0; i < size(); i++) {
+        (*bodies)[index[i]].force = force[i];
+        (*bodies)[index[i]].torque = torque[i];
+    }
+}
+
+void BodyState::compute_auxiliary(uint32_t i)
+{
+    v[i] = p[i] * inv_mass[i];
+    glm::dmat3 a = glm::mat3_cast(q[i]);
+    i_inv[i] = a * inv_moment_of_inertia[i] * glm::transpose(a);
+    omega[i] = i_inv[i] * l[i];
+}
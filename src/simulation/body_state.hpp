@@ -0,0 +1,75 @@
+#ifndef SIMULATION_BODY_STATE_HPP
+#define SIMULATION_BODY_STATE_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class RigidBody;
+
+/**
+ * The quantities of all bodies of a {BodySystem} with a separate array per quantity, such that the integrator and
+ * the forces, which touch few quantities of every body, stream over contiguous memory instead of over the
+ * {RigidBody} objects. It is a working copy: {load} reads the bodies once per step, after which the forces, the
+ * contact forces and the integrator work on it, and {store_state} writes the result back. Sleeping and finished
+ * bodies are left out. The arrays keep their capacity, so loading the same
+ * number of bodies does not allocate. */
+class BodyState {
+private:
+    /** Resizes all arrays to {n} bodies. */
+    void resize(uint32_t n);
+public:
+    /** Index in {BodySystem::bodies} of every body. */
+    std::vector<uint32_t> index;
+
+    /** Index in the arrays of every body of {BodySystem::bodies}, or -1 if it is left out. */
+    std::vector<int32_t> slot;
+
+    /** Quantities, see {RigidBody}. */
+    std::vector<glm::dvec3> x;
+    std::vector<glm::dvec3> p;
+    std::vector<glm::dquat> q;
+    std::vector<glm::dvec3> l;
+
+    /** Auxiliary quantities. */
+    std::vector<glm::dvec3> v;
+    std::vector<glm::dmat3> i_inv;
+    std::vector<glm::dvec3> omega;
+
+    /** Computed quantities, zero after {load}. */
+    std::vector<glm::dvec3> force;
+    std::vector<glm::dvec3> torque;
+
+    /** Constant quantities of the shapes. */
+    std::vector<double> inv_mass;
+    std::vector<glm::dmat3> inv_moment_of_inertia;
+
+    /** Scratch of {Integrator::runge_kutta_4}: the quantities at the start of the step, the weighted sum of the
+     *  changes and the change of the current stage. */
+    std::vector<glm::dvec3> x_0, p_0, l_0, v_0, omega_0, x_sum, p_sum, l_sum, x_delta, p_delta, l_delta;
+    std::vector<glm::dquat> q_0, q_sum, q_delta;
+
+    uint32_t size() const;
+
+    /** Reads the quantities of the bodies in {bodies} which are not asleep or finished. */
+    void load(const std::vector<RigidBody> &bodies);
+
+    /**
+     * Leaves out the bodies which have been marked finished in {bodies} since {load}, keeping the order and all
+     * quantities, including the scratch, of the others. */
+    void remove_finished(const std::vector<RigidBody> &bodies);
+
+    /** Writes the quantities and auxiliary quantities to {bodies}. */
+    void store_state(std::vector<RigidBody> *bodies) const;
+
+    /** Writes the computed quantities to {bodies}, for integrators which work on the {RigidBody} objects. */
+    void store_forces(std::vector<RigidBody> *bodies) const;
+
+    /** Recomputes the auxiliary quantities of body {i} from its quantities. */
+    void compute_auxiliary(uint32_t i);
+};
+
+#endif //SIMULATION_BODY_STATE_HPP
@@ -1,8 +1,36 @@
 #include "body_system.hpp"
+#include "engine.hpp"
+#include "broadphase/sweep_and_prune.hpp"
+#include "separating_feature_cache.hpp"
+#include "contact_manifold_cache.hpp"
+#include "thread_pool.hpp"
+
+BodySystem::BodySystem() :
+        broadphase(new SweepAndPrune(Engine::DISTANCE_THRESHOLD)), feature_cache(new SeparatingFeatureCache()),
+        manifold_cache(new ContactManifoldCache()), thread_pool(new ThreadPool(1)), solver_workspaces(1)
+{}
 
 BodySystem::~BodySystem()
 {
     for (auto &f : forces) {
         delete f;
     }
+    delete broadphase;
+    delete feature_cache;
+    delete manifold_cache;
+    delete thread_pool;
+}
+
+void BodySystem::set_broadphase(Broadphase *p_broadphase)
+{
+    delete broadphase;
+    broadphase = p_broadphase;
+}
+
+void BodySystem::set_thread_pool(ThreadPool *p_thread_pool)
+{
+    delete thread_pool;
+    thread_pool = p_thread_pool;
+    solver_workspaces.clear();
+    solver_workspaces.resize(thread_pool->get_thread_count());
 }
\ No newline at end of file
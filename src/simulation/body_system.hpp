@@ -6,21 +6,88 @@
 #include <iostream>
 
 #include "rigid_body.hpp"
+#include "body_state.hpp"
 #include "force/force.hpp"
+#include "broadphase/broadphase.hpp"
+#include "narrowphase_type.hpp"
+#include "contact_solver_type.hpp"
+#include "island.hpp"
+#include "math.hpp"
 
 class RigidBody;
 
 class Force;
 
+class SeparatingFeatureCache;
+
+class ContactManifoldCache;
+
+class ThreadPool;
+
 class BodySystem {
 public:
+    BodySystem();
+
     ~BodySystem();
 
+    /** Owns {forces}, {broadphase}, the caches and {thread_pool}, which a copy would delete twice. */
+    BodySystem(const BodySystem &) = delete;
+
+    BodySystem &operator=(const BodySystem &) = delete;
+
     /** List of forces, pointers due to abstract class implementations. */
     std::vector<Force *> forces;
 
     /** List of bodies, intentionally not pointers for easy copying. */
     std::vector<RigidBody> bodies;
+
+    /** Working copy of {bodies} for the integrator and the forces. */
+    BodyState body_state;
+
+    /** Finds the pairs of {bodies} that {CollisionDetection} has to test. */
+    Broadphase *broadphase;
+
+    /** Tests the pairs reported by {broadphase}. */
+    NarrowphaseType narrowphase_type = SAT;
+
+    /** Separating features of the pairs reported by {broadphase}, used by {CollisionDetection}. */
+    SeparatingFeatureCache *feature_cache;
+
+    /** Contacts and their forces of the last step, used as initial guess by {CollisionHandling}. */
+    ContactManifoldCache *manifold_cache;
+
+    /** Whether {CollisionHandling} solves the contact forces of every island separately. */
+    bool use_islands = true;
+
+    /** Islands found by {CollisionHandling}, if {use_islands}. */
+    IslandStatistics island_statistics;
+
+    /** Solves the islands found by {CollisionHandling} concurrently. */
+    ThreadPool *thread_pool;
+
+    /** Solves the forces of resting contacts in {CollisionHandling}. */
+    ContactSolverType contact_solver_type = DANTZIG;
+
+    /** Sweep budget and residual tolerance of {PROJECTED_GAUSS_SEIDEL}, see {math::pgs_solve}. */
+    uint32_t pgs_max_iterations = 50;
+    double pgs_tolerance = 1.e-6;
+
+    /** Whether bodies at rest are put to sleep, see {Sleeping}. */
+    bool use_sleeping = false;
+
+    /** Speeds below which a body rests, and the time it has to rest to be put to sleep, see {Sleeping}. */
+    double sleep_linear_velocity = .05;
+    double sleep_angular_velocity = .05;
+    double sleep_time = .5;
+
+    /** Buffers of the contact force solver for every thread of {thread_pool}, reused across steps. */
+    std::vector<math::SolverWorkspace> solver_workspaces;
+
+    /** Replaces {broadphase} by {p_broadphase}, of which ownership is taken. */
+    void set_broadphase(Broadphase *p_broadphase);
+
+    /** Replaces {thread_pool} by {p_thread_pool}, of which ownership is taken, with a workspace per thread. */
+    void set_thread_pool(ThreadPool *p_thread_pool);
 };
 
 #endif //SIMULATION_BODYSYSTEM_HPP
@@ -0,0 +1,71 @@
+#include "aabb.hpp"
+
+Aabb::Aabb(
+) :
+        min(glm::dvec3(0.)), max(glm::dvec3(0.))
+{}
+
+Aabb::Aabb(
+        glm::dvec3 p_min, glm::dvec3 p_max
+) :
+        min(p_min), max(p_max)
+{}
+
+Aabb::Aabb(
+        const RigidBody *body, double margin
+) :
+        Aabb()
+{
+    min = body->get_world_space_vertex(0);
+    max = min;
+    for (uint32_t i = 1; i < body->shape->get_model_vertices().size(); i++) {
+        glm::dvec3 v = body->get_world_space_vertex(i);
+        for (uint32_t j = 0; j < 3; j++) {
+            if (v[j] < min[j]) min[j] = v[j];
+            if (v[j] > max[j]) max[j] = v[j];
+        }
+    }
+
+    min -= glm::dvec3(margin);
+    max += glm::dvec3(margin);
+}
+
+bool Aabb::overlaps(const Aabb &other) const
+{
+    for (uint32_t i = 0; i < 3; i++) {
+        if (max[i] < other.min[i] || other.max[i] < min[i]) return false;
+    }
+
+    return true;
+}
+
+bool Aabb::contains(const Aabb &other) const
+{
+    for (uint32_t i = 0; i < 3; i++) {
+        if (other.min[i] < min[i] || other.max[i] > max[i]) return false;
+    }
+
+    return true;
+}
+
+Aabb Aabb::merge(const Aabb &other) const
+{
+    Aabb r_val;
+    for (uint32_t i = 0; i < 3; i++) {
+        r_val.min[i] = min[i] < other.min[i] ? min[i] : other.min[i];
+        r_val.max[i] = max[i] > other.max[i] ? max[i] : other.max[i];
+    }
+
+    return r_val;
+}
+
+Aabb Aabb::grow(double margin) const
+{
+    return {min - glm::dvec3(margin), max + glm::dvec3(margin)};
+}
+
+double Aabb::get_half_area() const
+{
+    glm::dvec3 d = max - min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
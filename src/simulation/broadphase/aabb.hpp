@@ -0,0 +1,37 @@
+#ifndef SIMULATION_AABB_HPP
+#define SIMULATION_AABB_HPP
+
+#include <glm/vec3.hpp>
+
+#include "../rigid_body.hpp"
+
+/** Axis-aligned bounding box in world space. */
+class Aabb {
+public:
+    glm::dvec3 min;
+    glm::dvec3 max;
+
+    Aabb();
+
+    Aabb(glm::dvec3 p_min, glm::dvec3 p_max);
+
+    /** Bounding box of the world space vertices of {body}, grown by {margin} in every direction. */
+    Aabb(const RigidBody *body, double margin);
+
+    /** Returns true if this box and {other} overlap, touching boxes are considered to overlap. */
+    bool overlaps(const Aabb &other) const;
+
+    /** Returns true if {other} lies completely inside this box. */
+    bool contains(const Aabb &other) const;
+
+    /** Returns the smallest box containing both this box and {other}. */
+    Aabb merge(const Aabb &other) const;
+
+    /** Returns this box grown by {margin} in every direction. */
+    Aabb grow(double margin) const;
+
+    /** Half of the surface area, used as cost metric. */
+    double get_half_area() const;
+};
+
+#endif //SIMULATION_AABB_HPP
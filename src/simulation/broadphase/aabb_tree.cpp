@@ -0,0 +1,270 @@
+#include "aabb_tree.hpp"
+
+bool AabbTree::Node::is_leaf() const
+{
+    return left == NULL_NODE;
+}
+
+int32_t AabbTree::allocate_node()
+{
+    int32_t node;
+    if (free_list != NULL_NODE) {
+        node = free_list;
+        free_list = nodes[node].parent;
+    } else {
+        node = (int32_t) nodes.size();
+        nodes.emplace_back();
+    }
+
+    nodes[node].parent = NULL_NODE;
+    nodes[node].left = NULL_NODE;
+    nodes[node].right = NULL_NODE;
+    nodes[node].height = 0;
+
+    return node;
+}
+
+void AabbTree::free_node(int32_t node)
+{
+    nodes[node].parent = free_list;
+    nodes[node].height = -1;
+    free_list = node;
+}
+
+int32_t AabbTree::insert(uint32_t body, const Aabb &aabb)
+{
+    int32_t leaf = allocate_node();
+    nodes[leaf].aabb = aabb;
+    nodes[leaf].body = body;
+    insert_leaf(leaf);
+
+    return leaf;
+}
+
+void AabbTree::remove(int32_t leaf)
+{
+    remove_leaf(leaf);
+    free_node(leaf);
+}
+
+void AabbTree::move(int32_t leaf, const Aabb &aabb)
+{
+    remove_leaf(leaf);
+    nodes[leaf].aabb = aabb;
+    insert_leaf(leaf);
+}
+
+const Aabb &AabbTree::get_aabb(int32_t leaf) const
+{
+    return nodes[leaf].aabb;
+}
+
+void AabbTree::insert_leaf(int32_t leaf)
+{
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // descend to the sibling for which the increase in surface area is smallest
+    Aabb leaf_aabb = nodes[leaf].aabb;
+    int32_t index = root;
+    while (!nodes[index].is_leaf()) {
+        int32_t left = nodes[index].left;
+        int32_t right = nodes[index].right;
+
+        double area = nodes[index].aabb.get_half_area();
+        double combined_area = nodes[index].aabb.merge(leaf_aabb).get_half_area();
+
+        // cost of creating a new parent for this node and the new leaf
+        double cost = 2. * combined_area;
+
+        // minimum cost of pushing the leaf further down the tree
+        double inheritance_cost = 2. * (combined_area - area);
+
+        double cost_left = nodes[left].aabb.merge(leaf_aabb).get_half_area() + inheritance_cost;
+        if (!nodes[left].is_leaf()) cost_left -= nodes[left].aabb.get_half_area();
+
+        double cost_right = nodes[right].aabb.merge(leaf_aabb).get_half_area() + inheritance_cost;
+        if (!nodes[right].is_leaf()) cost_right -= nodes[right].aabb.get_half_area();
+
+        if (cost < cost_left && cost < cost_right) break;
+
+        index = cost_left < cost_right ? left : right;
+    }
+
+    // create a new parent for the sibling and the leaf
+    int32_t sibling = index;
+    int32_t old_parent = nodes[sibling].parent;
+    int32_t new_parent = allocate_node();
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].aabb = leaf_aabb.merge(nodes[sibling].aabb);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].left = sibling;
+    nodes[new_parent].right = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if (old_parent == NULL_NODE) {
+        root = new_parent;
+    } else if (nodes[old_parent].left == sibling) {
+        nodes[old_parent].left = new_parent;
+    } else {
+        nodes[old_parent].right = new_parent;
+    }
+
+    refit_ancestors(leaf);
+}
+
+void AabbTree::remove_leaf(int32_t leaf)
+{
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    // replace the parent of the leaf by its sibling
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandparent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandparent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        free_node(parent);
+        return;
+    }
+
+    if (nodes[grandparent].left == parent) {
+        nodes[grandparent].left = sibling;
+    } else {
+        nodes[grandparent].right = sibling;
+    }
+    nodes[sibling].parent = grandparent;
+    free_node(parent);
+
+    refit_ancestors(sibling);
+}
+
+void AabbTree::refit_ancestors(int32_t node)
+{
+    int32_t index = nodes[node].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        int32_t left = nodes[index].left;
+        int32_t right = nodes[index].right;
+        nodes[index].height = 1 + std::max(nodes[left].height, nodes[right].height);
+        nodes[index].aabb = nodes[left].aabb.merge(nodes[right].aabb);
+
+        index = nodes[index].parent;
+    }
+}
+
+int32_t AabbTree::balance(int32_t a)
+{
+    if (nodes[a].is_leaf() || nodes[a].height < 2) return a;
+
+    int32_t b = nodes[a].left;
+    int32_t c = nodes[a].right;
+    int32_t diff = nodes[c].height - nodes[b].height;
+
+    if (diff > 1) {
+        // rotate c up
+        int32_t f = nodes[c].left;
+        int32_t g = nodes[c].right;
+
+        nodes[c].left = a;
+        nodes[c].parent = nodes[a].parent;
+        nodes[a].parent = c;
+
+        if (nodes[c].parent == NULL_NODE) {
+            root = c;
+        } else if (nodes[nodes[c].parent].left == a) {
+            nodes[nodes[c].parent].left = c;
+        } else {
+            nodes[nodes[c].parent].right = c;
+        }
+
+        // keep the highest child of c, move the other to a
+        int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+        int32_t give = keep == f ? g : f;
+        nodes[c].right = keep;
+        nodes[a].right = give;
+        nodes[give].parent = a;
+        nodes[a].aabb = nodes[b].aabb.merge(nodes[give].aabb);
+        nodes[c].aabb = nodes[a].aabb.merge(nodes[keep].aabb);
+        nodes[a].height = 1 + std::max(nodes[b].height, nodes[give].height);
+        nodes[c].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+
+        return c;
+    }
+
+    if (diff < -1) {
+        // rotate b up
+        int32_t d = nodes[b].left;
+        int32_t e = nodes[b].right;
+
+        nodes[b].left = a;
+        nodes[b].parent = nodes[a].parent;
+        nodes[a].parent = b;
+
+        if (nodes[b].parent == NULL_NODE) {
+            root = b;
+        } else if (nodes[nodes[b].parent].left == a) {
+            nodes[nodes[b].parent].left = b;
+        } else {
+            nodes[nodes[b].parent].right = b;
+        }
+
+        // keep the highest child of b, move the other to a
+        int32_t keep = nodes[d].height > nodes[e].height ? d : e;
+        int32_t give = keep == d ? e : d;
+        nodes[b].right = keep;
+        nodes[a].left = give;
+        nodes[give].parent = a;
+        nodes[a].aabb = nodes[c].aabb.merge(nodes[give].aabb);
+        nodes[b].aabb = nodes[a].aabb.merge(nodes[keep].aabb);
+        nodes[a].height = 1 + std::max(nodes[c].height, nodes[give].height);
+        nodes[b].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+
+        return b;
+    }
+
+    return a;
+}
+
+void AabbTree::query(const Aabb &aabb, std::vector<uint32_t> *bodies) const
+{
+    if (root == NULL_NODE) return;
+
+    // small fixed-size stack suffices since the tree is balanced
+    int32_t stack[256];
+    uint32_t count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        const Node &node = nodes[stack[--count]];
+        if (!node.aabb.overlaps(aabb)) continue;
+
+        if (node.is_leaf()) {
+            bodies->emplace_back(node.body);
+        } else {
+            assert(count + 2 <= 256);
+            stack[count++] = node.left;
+            stack[count++] = node.right;
+        }
+    }
+}
+
+void AabbTree::clear()
+{
+    nodes.clear();
+    root = NULL_NODE;
+    free_list = NULL_NODE;
+}
+
+int32_t AabbTree::get_height() const
+{
+    return root == NULL_NODE ? -1 : nodes[root].height;
+}
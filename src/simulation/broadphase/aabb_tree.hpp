@@ -0,0 +1,74 @@
+#ifndef SIMULATION_AABB_TREE_HPP
+#define SIMULATION_AABB_TREE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+#include "aabb.hpp"
+
+/**
+ * Dynamic bounding volume hierarchy of axis-aligned bounding boxes. Leaves are inserted at the position that
+ * least increases the surface area of the tree, and the tree is kept balanced by rotations on the way up.
+ * Nodes are stored in a pool and referred to by index, freed nodes are reused. */
+class AabbTree {
+public:
+    /** Index denoting the absence of a node. */
+    static const int32_t NULL_NODE = -1;
+private:
+    struct Node {
+        Aabb aabb;
+        int32_t parent;
+        int32_t left;
+        int32_t right;
+        /** Height of the subtree, leaves have height 0 and free nodes have height -1. */
+        int32_t height;
+        /** If a leaf, the body it belongs to. Else undefined. */
+        uint32_t body;
+
+        bool is_leaf() const;
+    };
+
+    std::vector<Node> nodes;
+
+    int32_t root = NULL_NODE;
+
+    /** First node of the list of free nodes, linked by {Node::parent}. */
+    int32_t free_list = NULL_NODE;
+
+    int32_t allocate_node();
+
+    void free_node(int32_t node);
+
+    void insert_leaf(int32_t leaf);
+
+    void remove_leaf(int32_t leaf);
+
+    /** Performs a rotation if the subtree rooted at {a} is imbalanced, returns the new root of the subtree. */
+    int32_t balance(int32_t a);
+
+    /** Recompute the box and height of the ancestors of {node}, balancing the tree on the way up. */
+    void refit_ancestors(int32_t node);
+public:
+    /** Inserts a leaf for {body} with {aabb}, returns the leaf. */
+    int32_t insert(uint32_t body, const Aabb &aabb);
+
+    /** Removes {leaf} from the tree. */
+    void remove(int32_t leaf);
+
+    /** Replaces the box of {leaf} by {aabb}. */
+    void move(int32_t leaf, const Aabb &aabb);
+
+    const Aabb &get_aabb(int32_t leaf) const;
+
+    /** Appends the bodies of all leaves of which the box overlaps {aabb} to {bodies}. */
+    void query(const Aabb &aabb, std::vector<uint32_t> *bodies) const;
+
+    void clear();
+
+    /** Height of the tree, -1 if empty. */
+    int32_t get_height() const;
+};
+
+#endif //SIMULATION_AABB_TREE_HPP
@@ -0,0 +1,67 @@
+#include "aabb_tree_broadphase.hpp"
+
+AabbTreeBroadphase::AabbTreeBroadphase(double p_margin) : Broadphase(p_margin)
+{}
+
+void AabbTreeBroadphase::rebuild(const std::vector<RigidBody> &bodies)
+{
+    static_tree.clear();
+    dynamic_tree.clear();
+    aabbs.clear();
+    leaves.clear();
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        aabbs.emplace_back(&bodies[i], margin);
+        if (bodies[i].shape->get_inv_mass() == 0.) {
+            leaves.emplace_back(static_tree.insert(i, aabbs[i]));
+        } else {
+            leaves.emplace_back(dynamic_tree.insert(i, aabbs[i].grow(FAT_MARGIN)));
+        }
+    }
+}
+
+void AabbTreeBroadphase::update(const std::vector<RigidBody> &bodies)
+{
+    if (bodies.size() != aabbs.size()) {
+        // bodies have been added or removed, start over
+        rebuild(bodies);
+    } else {
+        for (uint32_t i = 0; i < bodies.size(); i++) {
+            // immovable bodies stay in place
+            if (bodies[i].shape->get_inv_mass() == 0.) continue;
+
+            aabbs[i] = Aabb(&bodies[i], margin);
+            if (!dynamic_tree.get_aabb(leaves[i]).contains(aabbs[i])) {
+                // the body has left its fattened box
+                dynamic_tree.move(leaves[i], aabbs[i].grow(FAT_MARGIN));
+            }
+        }
+    }
+
+    pairs.clear();
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        if (bodies[i].shape->get_inv_mass() == 0.) continue;
+
+        found.clear();
+        static_tree.query(aabbs[i], &found);
+        dynamic_tree.query(aabbs[i], &found);
+        for (auto &j : found) {
+            // a pair of movable bodies is found by both, only report it once
+            if (j == i || (j < i && bodies[j].shape->get_inv_mass() != 0.)) continue;
+            // the tree contains fattened boxes, filter by the actual boxes
+            if (!aabbs[i].overlaps(aabbs[j])) continue;
+            pairs.emplace_back(std::min(i, j), std::max(i, j));
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+}
+
+void AabbTreeBroadphase::query(const Aabb &aabb, std::vector<uint32_t> *bodies) const
+{
+    found.clear();
+    static_tree.query(aabb, &found);
+    dynamic_tree.query(aabb, &found);
+    for (auto &i : found) {
+        // the tree contains fattened boxes, filter by the actual boxes
+        if (aabb.overlaps(aabbs[i])) bodies->emplace_back(i);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef SIMULATION_AABB_TREE_BROADPHASE_HPP
+#define SIMULATION_AABB_TREE_BROADPHASE_HPP
+
+#include <algorithm>
+
+#include "broadphase.hpp"
+#include "aabb_tree.hpp"
+
+/**
+ * Broadphase based on two dynamic bounding volume hierarchies. Immovable bodies are inserted once into a static
+ * tree. Movable bodies are inserted into a dynamic tree with a box that is fattened by {FAT_MARGIN}, the tree is
+ * only changed when a body moves out of its fattened box. Every movable body queries both trees. */
+class AabbTreeBroadphase : public Broadphase {
+private:
+    /** Distance with which the boxes in the dynamic tree are fattened. */
+    static constexpr double const FAT_MARGIN = .3;
+
+    AabbTree static_tree;
+
+    AabbTree dynamic_tree;
+
+    /** Leaf in either tree of every body. */
+    std::vector<int32_t> leaves;
+
+    /** Scratch list for the results of a query. */
+    mutable std::vector<uint32_t> found;
+
+    void rebuild(const std::vector<RigidBody> &bodies);
+public:
+    explicit AabbTreeBroadphase(double p_margin);
+
+    void update(const std::vector<RigidBody> &bodies) override;
+
+    void query(const Aabb &aabb, std::vector<uint32_t> *bodies) const override;
+};
+
+#endif //SIMULATION_AABB_TREE_BROADPHASE_HPP
@@ -0,0 +1,22 @@
+#include "all_pairs.hpp"
+
+AllPairs::AllPairs(double p_margin) : Broadphase(p_margin)
+{}
+
+void AllPairs::update(const std::vector<RigidBody> &bodies)
+{
+    body_count = bodies.size();
+    pairs.clear();
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        for (uint32_t j = i + 1; j < bodies.size(); j++) {
+            pairs.emplace_back(i, j);
+        }
+    }
+}
+
+void AllPairs::query(const Aabb &, std::vector<uint32_t> *bodies) const
+{
+    for (uint32_t i = 0; i < body_count; i++) {
+        bodies->emplace_back(i);
+    }
+}
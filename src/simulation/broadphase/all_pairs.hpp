@@ -0,0 +1,21 @@
+#ifndef SIMULATION_ALL_PAIRS_HPP
+#define SIMULATION_ALL_PAIRS_HPP
+
+#include "broadphase.hpp"
+
+/**
+ * Reports every pair of bodies, including pairs of immovable bodies.
+ * Equivalent to the exhaustive double loop, used as reference. */
+class AllPairs : public Broadphase {
+private:
+    uint32_t body_count = 0;
+public:
+    explicit AllPairs(double p_margin);
+
+    void update(const std::vector<RigidBody> &bodies) override;
+
+    /** Does not compute bounding boxes, so every body is reported. */
+    void query(const Aabb &aabb, std::vector<uint32_t> *bodies) const override;
+};
+
+#endif //SIMULATION_ALL_PAIRS_HPP
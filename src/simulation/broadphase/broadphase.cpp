@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "broadphase.hpp"
+#include "all_pairs.hpp"
+#include "sweep_and_prune.hpp"
+#include "aabb_tree_broadphase.hpp"
+#include "spatial_hash_broadphase.hpp"
+
+Broadphase::Broadphase(double p_margin) : margin(p_margin)
+{}
+
+Broadphase::~Broadphase()
+{}
+
+Broadphase *Broadphase::create(BroadphaseType type, double margin)
+{
+    switch (type) {
+        case ALL_PAIRS:
+            return new AllPairs(margin);
+        case SWEEP_AND_PRUNE:
+            return new SweepAndPrune(margin);
+        case AABB_TREE:
+            return new AabbTreeBroadphase(margin);
+        case SPATIAL_HASH:
+            return new SpatialHashBroadphase(margin);
+    }
+
+    // only reached if {type} was cast from a value which is not a {BroadphaseType}
+    fprintf(stderr, "unknown broadphase type %d\n", (int) type);
+    abort();
+}
+
+bool Broadphase::is_static_pair(const RigidBody *x, const RigidBody *y)
+{
+    return x->shape->get_inv_mass() == 0. && y->shape->get_inv_mass() == 0.;
+}
+
+void Broadphase::query(const Aabb &aabb, std::vector<uint32_t> *bodies) const
+{
+    for (uint32_t i = 0; i < aabbs.size(); i++) {
+        if (aabb.overlaps(aabbs[i])) bodies->emplace_back(i);
+    }
+}
+
+const std::vector<std::pair<uint32_t, uint32_t>> &Broadphase::get_pairs() const
+{
+    return pairs;
+}
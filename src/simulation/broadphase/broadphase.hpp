@@ -0,0 +1,65 @@
+#ifndef SIMULATION_BROADPHASE_HPP
+#define SIMULATION_BROADPHASE_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "../rigid_body.hpp"
+#include "aabb.hpp"
+
+/** Implementations of {Broadphase}, to select one at runtime with {Broadphase::create}. */
+enum BroadphaseType {
+    /** See {AllPairs}. */
+    ALL_PAIRS,
+    /** See {SweepAndPrune}. */
+    SWEEP_AND_PRUNE,
+    /** See {AabbTreeBroadphase}. */
+    AABB_TREE,
+    /** See {SpatialHashBroadphase}. */
+    SPATIAL_HASH
+};
+
+/**
+ * Finds the pairs of bodies that may be in contact, so that {CollisionDetection} only has to run
+ * {Collision::intersect} for those pairs. A pair is reported as (i, j) with i < j, the indices referring
+ * to {BodySystem::bodies}. Pairs are reported in the order of the exhaustive double loop over all bodies,
+ * so that the order in which contacts are created does not depend on the broadphase. */
+class Broadphase {
+protected:
+    /** Candidate pairs found by the last call to {update}. */
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+    /** Bounding box of every body as of the last call to {update}. */
+    std::vector<Aabb> aabbs;
+
+    /**
+     * Distance with which every bounding box is grown, such that pairs that are separated
+     * but within contact distance are still reported. */
+    double margin;
+
+    /** Pairs of immovable bodies can never interact, and are therefore not reported. */
+    static bool is_static_pair(const RigidBody *x, const RigidBody *y);
+public:
+    explicit Broadphase(double p_margin);
+
+    /**
+     * Creates a broadphase of the given {type}, which has to be deleted by the caller. Aborts if {type} is not one
+     * of {BroadphaseType}. */
+    static Broadphase *create(BroadphaseType type, double margin);
+
+    /** Bring the broadphase up to date with the current state of {bodies} and find the candidate pairs. */
+    virtual void update(const std::vector<RigidBody> &bodies) = 0;
+
+    /**
+     * Appends the indices of the bodies of which the bounding box may overlap {aabb} to {bodies}, as of the last
+     * call to {update}. The default implementation tests the box of every body. */
+    virtual void query(const Aabb &aabb, std::vector<uint32_t> *bodies) const;
+
+    /** Returns the candidate pairs found by the last call to {update}. */
+    const std::vector<std::pair<uint32_t, uint32_t>> &get_pairs() const;
+
+    virtual ~Broadphase();
+};
+
+#endif //SIMULATION_BROADPHASE_HPP
@@ -0,0 +1,142 @@
+#include "spatial_hash_broadphase.hpp"
+
+bool SpatialHashBroadphase::Entry::operator<(const Entry &other) const
+{
+    if (cell != other.cell) return cell < other.cell;
+    return body < other.body;
+}
+
+SpatialHashBroadphase::SpatialHashBroadphase(double p_margin) : Broadphase(p_margin)
+{}
+
+SpatialHashBroadphase::Cell SpatialHashBroadphase::get_cell(const glm::dvec3 &p) const
+{
+    return {(int32_t) std::floor(p.x / cell_size),
+            (int32_t) std::floor(p.y / cell_size),
+            (int32_t) std::floor(p.z / cell_size)};
+}
+
+uint64_t SpatialHashBroadphase::get_key(int32_t x, int32_t y, int32_t z)
+{
+    const uint64_t MASK = (1u << 21u) - 1u;
+    return ((uint64_t) x & MASK) << 42u | ((uint64_t) y & MASK) << 21u | ((uint64_t) z & MASK);
+}
+
+void SpatialHashBroadphase::update(const std::vector<RigidBody> &bodies)
+{
+    aabbs.clear();
+    pairs.clear();
+    entries.clear();
+    large.clear();
+    ranges.assign(bodies.size(), {});
+
+    // the cell fits the largest movable body
+    cell_size = 0.;
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        aabbs.emplace_back(&bodies[i], margin);
+        if (bodies[i].shape->get_inv_mass() == 0.) continue;
+        glm::dvec3 extent = aabbs[i].max - aabbs[i].min;
+        cell_size = std::max(cell_size, std::max(extent.x, std::max(extent.y, extent.z)));
+    }
+
+    // without movable bodies, there are no pairs
+    if (cell_size == 0.) return;
+
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        glm::dvec3 extent = aabbs[i].max - aabbs[i].min;
+        if (std::max(extent.x, std::max(extent.y, extent.z)) > cell_size) {
+            large.emplace_back(i);
+            continue;
+        }
+
+        Cell lo = get_cell(aabbs[i].min);
+        Cell hi = get_cell(aabbs[i].max);
+        ranges[i] = std::make_pair(lo, hi);
+        for (int32_t x = lo.x; x <= hi.x; x++) {
+            for (int32_t y = lo.y; y <= hi.y; y++) {
+                for (int32_t z = lo.z; z <= hi.z; z++) {
+                    entries.push_back({get_key(x, y, z), i});
+                }
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+
+    for (uint32_t begin = 0, end; begin < entries.size(); begin = end) {
+        // find the bodies sharing this cell
+        end = begin + 1;
+        while (end < entries.size() && entries[end].cell == entries[begin].cell) end++;
+
+        for (uint32_t j = begin; j < end; j++) {
+            for (uint32_t k = j + 1; k < end; k++) {
+                uint32_t x = entries[j].body;
+                uint32_t y = entries[k].body;
+                if (is_static_pair(&bodies[x], &bodies[y])) continue;
+                if (!aabbs[x].overlaps(aabbs[y])) continue;
+
+                // a pair may share up to eight cells, only report it in the lowest cell they share
+                const std::pair<Cell, Cell> &rx = ranges[x];
+                const std::pair<Cell, Cell> &ry = ranges[y];
+                uint64_t lowest = get_key(
+                        std::max(rx.first.x, ry.first.x),
+                        std::max(rx.first.y, ry.first.y),
+                        std::max(rx.first.z, ry.first.z));
+                if (lowest != entries[begin].cell) continue;
+
+                pairs.emplace_back(x, y);
+            }
+        }
+    }
+
+    // test the large bodies against all other bodies
+    for (auto &i : large) {
+        for (uint32_t j = 0; j < bodies.size(); j++) {
+            if (j == i) continue;
+            // a pair of large bodies is found twice, only report it once
+            if (j < i && std::binary_search(large.begin(), large.end(), j)) continue;
+            if (is_static_pair(&bodies[i], &bodies[j])) continue;
+            if (!aabbs[i].overlaps(aabbs[j])) continue;
+
+            pairs.emplace_back(std::min(i, j), std::max(i, j));
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+}
+
+void SpatialHashBroadphase::query(const Aabb &aabb, std::vector<uint32_t> *bodies) const
+{
+    if (cell_size == 0.) {
+        Broadphase::query(aabb, bodies);
+        return;
+    }
+
+    Cell lo = get_cell(aabb.min);
+    Cell hi = get_cell(aabb.max);
+    uint64_t cell_count = (uint64_t) (hi.x - lo.x + 1) * (uint64_t) (hi.y - lo.y + 1) * (uint64_t) (hi.z - lo.z + 1);
+    if (cell_count > entries.size()) {
+        // the box spans more cells than there are entries, testing every body is cheaper
+        Broadphase::query(aabb, bodies);
+        return;
+    }
+
+    std::vector<uint32_t> found(large);
+    for (int32_t x = lo.x; x <= hi.x; x++) {
+        for (int32_t y = lo.y; y <= hi.y; y++) {
+            for (int32_t z = lo.z; z <= hi.z; z++) {
+                Entry first = {get_key(x, y, z), 0};
+                for (auto it = std::lower_bound(entries.begin(), entries.end(), first);
+                     it != entries.end() && it->cell == first.cell; it++) {
+                    found.emplace_back(it->body);
+                }
+            }
+        }
+    }
+
+    // bodies spanning multiple cells are found multiple times
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    for (auto &i : found) {
+        if (aabb.overlaps(aabbs[i])) bodies->emplace_back(i);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef SIMULATION_SPATIAL_HASH_BROADPHASE_HPP
+#define SIMULATION_SPATIAL_HASH_BROADPHASE_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "broadphase.hpp"
+
+/**
+ * Broadphase based on a uniform grid, rebuilt at every update. The size of a cell is the largest extent of the
+ * box of any movable body, such that a movable body lies in at most two cells along every axis. Every body is
+ * registered in the cells its box overlaps, by sorting (cell, body) entries on the key of the cell, and only
+ * bodies sharing a cell are tested. Bodies that are larger than a cell, such as the immovable surface, are
+ * not registered but are tested against every other body. This suits dense piles of equally sized dice. */
+class SpatialHashBroadphase : public Broadphase {
+private:
+    struct Entry {
+        /** Key of the cell, see {get_key}. */
+        uint64_t cell;
+        /** Index of the body. */
+        uint32_t body;
+
+        bool operator<(const Entry &other) const;
+    };
+
+    /** Coordinates of a cell, per axis. */
+    struct Cell {
+        int32_t x, y, z;
+    };
+
+    /** Edge length of a cell, as of the last call to {update}. */
+    double cell_size = 0.;
+
+    /** Entries of all registered bodies, sorted on cell. */
+    std::vector<Entry> entries;
+
+    /** Lowest and highest cell of every body. */
+    std::vector<std::pair<Cell, Cell>> ranges;
+
+    /** Bodies that are not registered in the grid, as they do not fit in a single cell. */
+    std::vector<uint32_t> large;
+
+    /** Index of the cell containing {p}. */
+    Cell get_cell(const glm::dvec3 &p) const;
+
+    /** Unique key of {cell}, the coordinates are packed into 21 bits each. */
+    static uint64_t get_key(int32_t x, int32_t y, int32_t z);
+public:
+    explicit SpatialHashBroadphase(double p_margin);
+
+    void update(const std::vector<RigidBody> &bodies) override;
+
+    void query(const Aabb &aabb, std::vector<uint32_t> *bodies) const override;
+};
+
+#endif //SIMULATION_SPATIAL_HASH_BROADPHASE_HPP
@@ -0,0 +1,99 @@
+#include "sweep_and_prune.hpp"
+
+bool SweepAndPrune::Endpoint::operator<(const Endpoint &other) const
+{
+    if (value != other.value) return value < other.value;
+    return is_min && !other.is_min;
+}
+
+SweepAndPrune::SweepAndPrune(double p_margin) : Broadphase(p_margin)
+{}
+
+void SweepAndPrune::update(const std::vector<RigidBody> &bodies)
+{
+    current_bodies = &bodies;
+
+    if (bodies.size() != aabbs.size()) {
+        // bodies have been added or removed, start over
+        rebuild(bodies);
+    } else {
+        for (uint32_t i = 0; i < bodies.size(); i++) {
+            aabbs[i] = Aabb(&bodies[i], margin);
+        }
+
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            // move the new bounds into the endpoints, and restore the order
+            for (auto &endpoint : endpoints[axis]) {
+                endpoint.value = endpoint.is_min ? aabbs[endpoint.body].min[axis] : aabbs[endpoint.body].max[axis];
+            }
+            sort_axis(axis);
+        }
+    }
+
+    pairs.assign(overlapping.begin(), overlapping.end());
+}
+
+void SweepAndPrune::rebuild(const std::vector<RigidBody> &bodies)
+{
+    aabbs.clear();
+    overlapping.clear();
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        aabbs.emplace_back(&bodies[i], margin);
+    }
+
+    for (uint32_t axis = 0; axis < 3; axis++) {
+        endpoints[axis].clear();
+        for (uint32_t i = 0; i < bodies.size(); i++) {
+            endpoints[axis].push_back({aabbs[i].min[axis], i, true});
+            endpoints[axis].push_back({aabbs[i].max[axis], i, false});
+        }
+        std::sort(endpoints[axis].begin(), endpoints[axis].end());
+    }
+
+    // sweep along the x-axis, a pair overlaps if the boxes overlap along all axes
+    std::vector<uint32_t> active;
+    for (auto &endpoint : endpoints[0]) {
+        if (endpoint.is_min) {
+            for (auto &other : active) {
+                if (aabbs[endpoint.body].overlaps(aabbs[other])) add_pair(endpoint.body, other);
+            }
+            active.emplace_back(endpoint.body);
+        } else {
+            active.erase(std::find(active.begin(), active.end(), endpoint.body));
+        }
+    }
+}
+
+void SweepAndPrune::sort_axis(uint32_t axis)
+{
+    std::vector<Endpoint> &e = endpoints[axis];
+    for (uint32_t i = 1; i < e.size(); i++) {
+        Endpoint endpoint = e[i];
+        uint32_t j = i;
+        // move the endpoint to the left, every endpoint it passes is a swap
+        while (j > 0 && endpoint < e[j - 1]) {
+            const Endpoint &passed = e[j - 1];
+            if (endpoint.is_min && !passed.is_min) {
+                // lower bound passes an upper bound, the pair may start to overlap
+                if (aabbs[endpoint.body].overlaps(aabbs[passed.body])) add_pair(endpoint.body, passed.body);
+            } else if (!endpoint.is_min && passed.is_min) {
+                // upper bound passes a lower bound, the pair stops to overlap along this axis
+                remove_pair(endpoint.body, passed.body);
+            }
+            e[j] = passed;
+            j--;
+        }
+        e[j] = endpoint;
+    }
+}
+
+void SweepAndPrune::add_pair(uint32_t x, uint32_t y)
+{
+    if (is_static_pair(&(*current_bodies)[x], &(*current_bodies)[y])) return;
+    overlapping.insert(x < y ? std::make_pair(x, y) : std::make_pair(y, x));
+}
+
+void SweepAndPrune::remove_pair(uint32_t x, uint32_t y)
+{
+    overlapping.erase(x < y ? std::make_pair(x, y) : std::make_pair(y, x));
+}
@@ -0,0 +1,51 @@
+#ifndef SIMULATION_SWEEP_AND_PRUNE_HPP
+#define SIMULATION_SWEEP_AND_PRUNE_HPP
+
+#include <set>
+#include <algorithm>
+
+#include "broadphase.hpp"
+
+/**
+ * Persistent sweep and prune. The endpoints of the bounding boxes are kept sorted along every axis, and since
+ * bodies move little between two updates, an insertion sort brings them back in order in nearly linear time.
+ * Every swap of two endpoints is an event where a pair starts or stops overlapping along that axis, only then
+ * the set of overlapping pairs has to be changed. */
+class SweepAndPrune : public Broadphase {
+private:
+    struct Endpoint {
+        double value;
+        /** Index of the body this endpoint belongs to. */
+        uint32_t body;
+        /** True if this is the lower bound of the box, false if it is the upper bound. */
+        bool is_min;
+
+        /** Sorting order, at equal values lower bounds come first such that touching boxes overlap. */
+        bool operator<(const Endpoint &other) const;
+    };
+
+    /** Sorted endpoints along the x, y, and z axis. */
+    std::vector<Endpoint> endpoints[3];
+
+    /** Pairs of which the bounding boxes currently overlap. */
+    std::set<std::pair<uint32_t, uint32_t>> overlapping;
+
+    /** Pointer to the bodies during an update, to filter pairs of immovable bodies. */
+    const std::vector<RigidBody> *current_bodies = nullptr;
+
+    /** Sort all endpoints from scratch and find the overlapping pairs with a single sweep. */
+    void rebuild(const std::vector<RigidBody> &bodies);
+
+    /** Restore the order of the endpoints along {axis}, processing the swaps. */
+    void sort_axis(uint32_t axis);
+
+    void add_pair(uint32_t x, uint32_t y);
+
+    void remove_pair(uint32_t x, uint32_t y);
+public:
+    explicit SweepAndPrune(double p_margin);
+
+    void update(const std::vector<RigidBody> &bodies) override;
+};
+
+#endif //SIMULATION_SWEEP_AND_PRUNE_HPP
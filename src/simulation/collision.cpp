@@ -24,6 +24,17 @@ double Collision::IntersectResult::dist(glm::dvec3 v) const
     return glm::dot(n, v - p);
 }
 
+/**
+ * Distance within which a vertex of the body the plane lies on is considered to lie on the plane, as the vertices
+ * of the edge forming the plane lie on it but due to rounding may end up on either side. */
+const double ON_PLANE_TOLERANCE = 1e-9;
+
+/**
+ * Number of vertices from which {which_side} finds the extreme vertices with {RigidBody::support}. For fewer
+ * vertices classifying all of them with {PlaneKernel} is faster, which stops as soon as vertices are found on
+ * either side. */
+const uint32_t SUPPORT_MIN_VERTICES = 128;
+
 /**
  * Tests on which side the vertices of {e} lie
  * compared to a plane formed by {p} and {n} which lies on {e}.
@@ -31,120 +42,234 @@ double Collision::IntersectResult::dist(glm::dvec3 v) const
  */
 int32_t which_side(RigidBody *e, glm::dvec3 p, glm::dvec3 n)
 {
-    uint32_t positive = 0;
-    uint32_t negative = 0;
-    // iterate vertices of e
-    for (uint32_t i = 0; i < e->shape->get_model_vertices().size(); i++) {
-        glm::dvec3 v = e->get_world_space_vertex(i);
-        double t = glm::dot(n, v - p);
-        if (t > 0) positive++; else if (t < 0) negative++;
-        if (positive && negative) return 0;
-    }
-
-    if (positive) {
+    const std::vector<glm::dvec3> &vertices = e->get_world_space_vertices();
+    if (vertices.size() >= SUPPORT_MIN_VERTICES) {
+        // only the vertices furthest along n and -n decide on which side the vertices lie
+        if (glm::dot(n, vertices[e->support(n)] - p) <= ON_PLANE_TOLERANCE) return -1;
+        if (glm::dot(n, vertices[e->support(-n)] - p) < -ON_PLANE_TOLERANCE) return 0;
         return +1;
-    } else {
-        return -1;
     }
+
+    return PlaneKernel::which_side(e->get_world_space_vertex_arrays(), glm::dvec3(0.), p, n, ON_PLANE_TOLERANCE);
 }
 
 /**
  * Tests on which side the (offset) vertices of {c} lie
- * compared to a plane formed by {p} and {n} which lies on {d}.
+ * compared to a plane formed by {p} and {n} which lies on {d}, where {n} points outwards from {d}.
  * todo this method misses the case where all vertices of a lie on the plane formed by p and n
  */
 int32_t which_side(RigidBody *c, RigidBody *d, glm::dvec3 p, glm::dvec3 n, double offset)
 {
-    uint32_t positive = 0;
-    uint32_t negative = 0;
-    // iterate vertices of c
-    for (uint32_t i = 0; i < c->shape->get_model_vertices().size(); i++) {
-        glm::dvec3 v = c->get_world_space_vertex(i, offset, d->x - c->x);
-        double t = glm::dot(n, v - p);
-        if (t > 0) positive++; else if (t < 0) negative++;
-        if (positive && negative) return 0;
+    // the offset is the same for every vertex. translated towards {d}, {c} moves along the line between the
+    // centers. translated apart, it moves along {n}, such that the depth of an interpenetration is measured along
+    // the normal of the plane and not along the line between the centers, which may be nearly parallel to the plane
+    glm::dvec3 translation = offset > 0. ? offset * glm::normalize(d->x - c->x) : -offset * n;
+    const std::vector<glm::dvec3> &vertices = c->get_world_space_vertices();
+    if (vertices.size() >= SUPPORT_MIN_VERTICES) {
+        // only the vertices furthest along n and -n decide on which side the vertices lie
+        if (glm::dot(n, vertices[c->support(n)] + translation - p) <= 0) return -1;
+        if (glm::dot(n, vertices[c->support(-n)] + translation - p) < 0) return 0;
+        return +1;
     }
 
-    if (positive) {
-        return +1;
-    } else {
-        return -1;
+    return PlaneKernel::which_side(c->get_world_space_vertex_arrays(), translation, p, n, 0.);
+}
+
+/**
+ * Tests whether the plane formed by face {i} of {b} separates the (offset) vertices of {a}.
+ * (we know that the vertices of b all lie on the negative side of this plane) */
+bool test_face(RigidBody *a, RigidBody *b, uint32_t i, double offset, Collision::IntersectResult *result)
+{
+    glm::dvec3 p = b->get_world_space_vertex(b->shape->get_faces()[i][0].first);
+    glm::dvec3 n = b->get_unit_normal(i);
+    if (which_side(a, b, p, n, offset) > 0) {
+        *result = {p, n, a, b, i};
+        return true;
     }
+
+    return false;
 }
 
-Collision::IntersectResult Collision::intersect(RigidBody *x, RigidBody *y, double offset)
+/** Edge {i} of x and edge {j} of y in world space, and the normal of the planes they form. */
+struct EdgePair {
+    glm::dvec3 ex0, ex;
+    glm::dvec3 ey0, ey;
+    glm::dvec3 n;
+
+    EdgePair(RigidBody *x, RigidBody *y, uint32_t i, uint32_t j)
+    {
+        ex0 = x->get_world_space_vertex(x->shape->get_edges()[i].first);
+        glm::dvec3 ex1 = x->get_world_space_vertex(x->shape->get_edges()[i].second);
+        ex = glm::normalize(ex0 - ex1);
+        ey0 = y->get_world_space_vertex(y->shape->get_edges()[j].first);
+        glm::dvec3 ey1 = y->get_world_space_vertex(y->shape->get_edges()[j].second);
+        ey = glm::normalize(ey0 - ey1);
+
+        n = glm::normalize(glm::cross(ex, ey));
+    }
+};
+
+/**
+ * Tests whether the plane formed by edge pair {e} separates {x} and {y}, where the plane lies on the edge of
+ * {x} if {on_x} and on the edge of {y} otherwise. */
+bool test_edge_pair(
+        RigidBody *x, RigidBody *y, uint32_t i, uint32_t j, const EdgePair &e, bool on_x, double offset,
+        Collision::IntersectResult *result)
 {
     int32_t side_x, side_y;
+    glm::dvec3 ex = e.ex;
+    glm::dvec3 n = e.n;
 
-    // take x as b and test planes formed by faces of x against (offset) vertices of y
-    // (we know that the vertices of x all lie on the negative side of this plane
-    for (uint32_t i = 0; i < x->shape->get_faces().size(); i++) {
-        glm::dvec3 p = x->get_world_space_vertex(x->shape->get_faces()[i][0].first);
-        glm::dvec3 n = glm::normalize(x->get_non_unit_normal(i));
-        if (which_side(y, x, p, n, offset) > 0) {
-            return {p, n, y, x, i};
+    if (on_x) {
+        // take x as b
+        // test the plane formed by edge of x against vertices of x
+        side_x = which_side(x, e.ex0, n);
+        if (side_x == 0) return false;
+        // if the vertices of x lie on the positive side of the plane, the normal does not point outwards from b,
+        // so correct it
+        if (side_x == 1) {
+            ex *= -1.;
+            n = glm::normalize(glm::cross(ex, e.ey));
+        }
+
+        // test the plane formed by edge of x against (offset) vertices of y
+        side_y = which_side(y, x, e.ex0, n, offset);
+        if (side_y > 0) {
+            *result = {e.ex0, n, y, x, e.ey, ex, j, i};
+            return true;
         }
+    } else {
+        // take y as b
+        // test the plane formed by edge of y against vertices of y
+        side_y = which_side(y, e.ey0, n);
+        if (side_y == 0) return false;
+        // if the vertices of y lie on the positive side of the plane, the normal does not point outwards from b,
+        // so correct it
+        if (side_y == 1) {
+            ex *= -1.;
+            n = glm::normalize(glm::cross(ex, e.ey));
+        }
+
+        // test the plane formed by edge of y against (offset) vertices of x
+        side_x = which_side(x, y, e.ey0, n, offset);
+        if (side_x > 0) {
+            *result = {e.ey0, n, x, y, ex, e.ey, i, j};
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Collision::SeparatingFeature::SeparatingFeature(
+) :
+        ee(false), on_x(false), i(0), j(0)
+{}
+
+Collision::SeparatingFeature::SeparatingFeature(
+        const IntersectResult &result, const RigidBody *x
+) :
+        ee(result.ee), on_x(result.b == x)
+{
+    if (!ee) {
+        i = result.fbi;
+        j = 0;
+    } else if (on_x) {
+        // b is x, so the edge on a is the edge on y
+        i = result.ebi;
+        j = result.eai;
+    } else {
+        i = result.eai;
+        j = result.ebi;
     }
+}
+
+Collision::IntersectResult Collision::intersect(RigidBody *x, RigidBody *y, double offset)
+{
+    IntersectResult result;
 
+    // take x as b and test planes formed by faces of x against (offset) vertices of y
+    if (intersect_faces(y, x, offset, &result)) return result;
     // take y as b and test planes formed by faces of y against (offset) vertices of x
-    // (we know that the vertices of y all lie on the negative side of this plane)
-    for (uint32_t i = 0; i < y->shape->get_faces().size(); i++) {
-        glm::dvec3 p = y->get_world_space_vertex(y->shape->get_faces()[i][0].first);
-        glm::dvec3 n = glm::normalize(y->get_non_unit_normal(i));
-        if (which_side(x, y, p, n, offset) > 0) {
-            return {p, n, x, y, i};
-        }
+    if (intersect_faces(x, y, offset, &result)) return result;
+
+    if (intersect_edges(x, y, offset, &result)) return result;
+
+    return result; // default constructor sets intersect to true
+}
+
+bool Collision::intersect_faces(RigidBody *a, RigidBody *b, double offset, IntersectResult *result)
+{
+    for (uint32_t i = 0; i < b->shape->get_faces().size(); i++) {
+        if (test_face(a, b, i, offset, result)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Returns true if the arcs {a}-{b} and {c}-{d} on the Gauss map intersect, where {b_x_a} and {d_x_c} are the
+ * cross products of their endpoints. Based on Gregorius, The Separating Axis Test between Convex Polyhedra (2013).
+ */
+bool is_minkowski_face(
+        const glm::dvec3 &a, const glm::dvec3 &b, const glm::dvec3 &b_x_a,
+        const glm::dvec3 &c, const glm::dvec3 &d, const glm::dvec3 &d_x_c)
+{
+    // the arcs intersect if the endpoints of each arc lie on opposite sides of the plane through the other arc,
+    // and they lie in the same hemisphere
+    double cba = glm::dot(c, b_x_a);
+    double dba = glm::dot(d, b_x_a);
+    double adc = glm::dot(a, d_x_c);
+    double bdc = glm::dot(b, d_x_c);
+
+    return cba * dba < 0. && adc * bdc < 0. && cba * bdc > 0.;
+}
+
+/** Arc of an edge on the Gauss map, given by the normals of the adjacent faces and their cross product. */
+struct Arc {
+    glm::dvec3 a, b, b_x_a;
+};
+
+bool Collision::intersect_edges(RigidBody *x, RigidBody *y, double offset, IntersectResult *result)
+{
+    // the arcs of the edges of y on the Gauss map of the configuration space, which is mirrored
+    std::vector<Arc> arcs_y;
+    arcs_y.reserve(y->shape->get_edges().size());
+    for (auto &faces_y : y->shape->get_edge_faces()) {
+        glm::dvec3 c = -y->get_unit_normal(faces_y.first);
+        glm::dvec3 d = -y->get_unit_normal(faces_y.second);
+        arcs_y.push_back({c, d, glm::cross(d, c)});
     }
 
     for (uint32_t i = 0; i < x->shape->get_edges().size(); i++) {
-        glm::dvec3 ex0 = x->get_world_space_vertex(x->shape->get_edges()[i].first);
-        glm::dvec3 ex1 = x->get_world_space_vertex(x->shape->get_edges()[i].second);
-        glm::dvec3 ex = glm::normalize(ex0 - ex1);
+        // the arc of the edge of x on the Gauss map
+        const std::pair<uint32_t, uint32_t> &faces_x = x->shape->get_edge_faces()[i];
+        const glm::dvec3 &a = x->get_unit_normal(faces_x.first);
+        const glm::dvec3 &b = x->get_unit_normal(faces_x.second);
+        glm::dvec3 b_x_a = glm::cross(b, a);
         for (uint32_t j = 0; j < y->shape->get_edges().size(); j++) {
-            glm::dvec3 ey0 = y->get_world_space_vertex(y->shape->get_edges()[j].first);
-            glm::dvec3 ey1 = y->get_world_space_vertex(y->shape->get_edges()[j].second);
-            glm::dvec3 ey = glm::normalize(ey0 - ey1);
-
-            glm::dvec3 n = glm::normalize(glm::cross(ex, ey));
-
-            // take x as b
-            // test the plane formed by edge of x against (offset) vertices of y
-            side_y = which_side(y, x, ex0, n, offset);
-            if (side_y == 0) goto other_way;
-            // test the plane formed by edge of x against vertices of x
-            side_x = which_side(x, ex0, n);
-            if (side_x == 0) goto other_way;
-
-            if (side_x * side_y < 0) {
-                // if the vertices of x lie on the positive side of the plane, the normal does not point outwards
-                // from b, so correct it
-                if (side_x == 1) {
-                    ex *= -1.;
-                    n = glm::normalize(glm::cross(ex, ey));
-                }
-                return {ex0, n, y, x, ey, ex, j, i};
-            }
-
-            other_way:
-            // take y as b
-            // test the plane formed by edge of y against (offset) vertices of x
-            side_x = which_side(x, y, ey0, n, offset);
-            if (side_x == 0) continue;
-            // test the plane formed by edge of y against vertices of y
-            side_y = which_side(y, ey0, n);
-            if (side_y == 0) continue;
-
-            if (side_x * side_y < 0) {
-                // if the vertices of y lie on the positive side of the plane, the normal does not point outwards
-                // from b, so correct it
-                if (side_y == 1) {
-                    ex *= -1.;
-                    n = glm::normalize(glm::cross(ex, ey));
-                }
-                return {ey0, n, x, y, ex, ey, i, j};
-            }
+            // only if the arcs intersect, the edges form a face of the configuration space, and the normal of that
+            // face can be a separating axis. otherwise a plane through either edge intersects the other body, or a
+            // plane formed by a face separates the bodies further
+            const Arc &arc_y = arcs_y[j];
+            if (!is_minkowski_face(a, b, b_x_a, arc_y.a, arc_y.b, arc_y.b_x_a)) continue;
+
+            EdgePair e(x, y, i, j);
+            if (test_edge_pair(x, y, i, j, e, true, offset, result)) return true;
+            if (test_edge_pair(x, y, i, j, e, false, offset, result)) return true;
         }
     }
 
-    return {}; // default constructor sets intersect to true
+    return false;
+}
+
+bool Collision::test_feature(
+        RigidBody *x, RigidBody *y, const SeparatingFeature &feature, double offset, IntersectResult *result)
+{
+    if (!feature.ee) {
+        return feature.on_x ? test_face(y, x, feature.i, offset, result) : test_face(x, y, feature.i, offset, result);
+    }
+
+    return test_edge_pair(x, y, feature.i, feature.j, EdgePair(x, y, feature.i, feature.j), feature.on_x, offset,
+                          result);
 }
\ No newline at end of file
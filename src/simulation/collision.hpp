@@ -63,11 +63,47 @@ namespace Collision {
         double dist(glm::dvec3 v) const;
     };
 
+    /**
+     * Identifies the feature that formed the separating plane of an {IntersectResult} of {x} and {y},
+     * such that the same plane can be tested again after the bodies have moved. */
+    struct SeparatingFeature {
+        /** True if the plane is formed by the cross product of two edges, false if it is formed by a face. */
+        bool ee;
+        /** True if the plane lies on {x}, false if it lies on {y}. */
+        bool on_x;
+        /** If {ee}, the index of the edge on {x}. Else, the index of the face on the body the plane lies on. */
+        uint32_t i;
+        /** If {ee}, the index of the edge on {y}. */
+        uint32_t j;
+
+        SeparatingFeature();
+
+        /** Feature of {result}, which must not intersect. */
+        SeparatingFeature(const IntersectResult &result, const RigidBody *x);
+    };
+
     /**
      * Fills an IntersectResult struct for this pair of {x} and {y},
      * by performing a check whether a separating plane can be found between the pair of bodies,
-     * which either is defined by a face of either one, or a defined by the cross product of a pair of edges. */
+     * which either is defined by a face of either one, or a defined by the cross product of a pair of edges.
+     * The bodies are translated towards each other by {offset} along the line between their centers. A negative
+     * {offset} translates them apart along the normal of every tested plane instead, such that they intersect if
+     * they interpenetrate deeper than -{offset} along the normal of every plane. */
     IntersectResult intersect(RigidBody *x, RigidBody *y, double offset);
+
+    /**
+     * Part of {intersect}, only tests the planes formed by faces of {b} against the (offset) vertices of {a}.
+     * Returns true if {result} is filled. */
+    bool intersect_faces(RigidBody *a, RigidBody *b, double offset, IntersectResult *result);
+
+    /** Part of {intersect}, only tests the planes formed by pairs of edges. Returns true if {result} is filled. */
+    bool intersect_edges(RigidBody *x, RigidBody *y, double offset, IntersectResult *result);
+
+    /**
+     * Tests only whether the plane formed by {feature} separates {x} and {y}. If so, returns true and fills
+     * {result} as {intersect} would have if it had found this plane. */
+    bool test_feature(RigidBody *x, RigidBody *y, const SeparatingFeature &feature, double offset,
+                      IntersectResult *result);
 }
 
 #endif //SIMULATION_COLLISION_HPP
\ No newline at end of file
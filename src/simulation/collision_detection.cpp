@@ -1,60 +1,121 @@
 #include "collision_detection.hpp"
 #include "contact_derivation.hpp"
+#include "separating_feature_cache.hpp"
+#include "contact_manifold_cache.hpp"
+#include "gjk.hpp"
+#include "sleeping.hpp"
+
+/** Returns true if the pair needs to be tested, which is if either body is moved in the current step. */
+bool active_pair(BodySystem *body_system, const std::pair<uint32_t, uint32_t> &pair)
+{
+    return CollisionDetection::is_moving(&body_system->bodies[pair.first]) ||
+           CollisionDetection::is_moving(&body_system->bodies[pair.second]);
+}
+
+/** Returns the separating plane of {x} and {y} (translated towards each other by {offset}), if any. */
+Collision::IntersectResult intersect_pair(
+        BodySystem *body_system, const std::pair<uint32_t, uint32_t> &pair, double offset)
+{
+    RigidBody *x = &body_system->bodies[pair.first];
+    RigidBody *y = &body_system->bodies[pair.second];
+    if (body_system->narrowphase_type == GJK) return Gjk::intersect(x, y, offset);
+
+    return body_system->feature_cache->intersect(x, y, pair.first, pair.second, offset);
+}
+
+/** Returns true if {x} and {y} (translated towards each other by {offset}) intersect. */
+bool overlap_pair(BodySystem *body_system, const std::pair<uint32_t, uint32_t> &pair, double offset)
+{
+    RigidBody *x = &body_system->bodies[pair.first];
+    RigidBody *y = &body_system->bodies[pair.second];
+    if (body_system->narrowphase_type == GJK) return Gjk::overlap(x, y, offset);
+
+    return body_system->feature_cache->intersect(x, y, pair.first, pair.second, offset).intersect;
+}
+
+/**
+ * Returns true if the pair interpenetrates, or if it is in contact but no separating plane can be found.
+ * In the latter case contacts cannot be derived, the scan of {Collision::intersect} considers this to be
+ * interpenetration, but GJK may find the bodies to be apart if they are nearly touching. */
+bool penetrating_pair(BodySystem *body_system, const std::pair<uint32_t, uint32_t> &pair)
+{
+    if (overlap_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD)) return true;
+    if (body_system->narrowphase_type == SAT) return false;
+
+    return overlap_pair(body_system, pair, +Engine::DISTANCE_THRESHOLD) &&
+           intersect_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD).intersect;
+}
+
+bool CollisionDetection::is_moving(const RigidBody *body)
+{
+    return Sleeping::is_active(body) && !body->finished;
+}
 
 bool CollisionDetection::intersect(BodySystem *body_system)
 {
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        for (uint32_t j = i + 1; j < body_system->bodies.size(); j++) {
-            Collision::IntersectResult inner = Collision::intersect(
-                    &body_system->bodies[i], &body_system->bodies[j], -Engine::DISTANCE_THRESHOLD);
-
-            if (inner.intersect) {
-                // if a pair of bodies which are translated towards each other with distance Engine::DISTANCE_THRESHOLD
-                // intersect, interpenetration has occurred.
-                return true;
-            }
+    body_system->broadphase->update(body_system->bodies);
+    for (auto &pair : body_system->broadphase->get_pairs()) {
+        if (!active_pair(body_system, pair)) continue;
+        if (penetrating_pair(body_system, pair)) {
+            // if a pair of bodies which are translated towards each other with distance Engine::DISTANCE_THRESHOLD
+            // intersect, interpenetration has occurred.
+            return true;
         }
     }
 
     return false;
 }
 
+std::vector<std::pair<uint32_t, uint32_t>> CollisionDetection::find_penetrating_pairs(BodySystem *body_system)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    body_system->broadphase->update(body_system->bodies);
+    for (auto &pair : body_system->broadphase->get_pairs()) {
+        if (!active_pair(body_system, pair)) continue;
+        if (penetrating_pair(body_system, pair)) pairs.emplace_back(pair);
+    }
+
+    return pairs;
+}
+
 CollisionState CollisionDetection::find_collision_state(BodySystem *body_system)
 {
     CollisionState return_state = NOT_PENETRATING;
 
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        for (uint32_t j = i + 1; j < body_system->bodies.size(); j++) {
-            Collision::IntersectResult inner = Collision::intersect(
-                    &body_system->bodies[i], &body_system->bodies[j], -Engine::DISTANCE_THRESHOLD);
+    body_system->broadphase->update(body_system->bodies);
+    for (auto &pair : body_system->broadphase->get_pairs()) {
+        if (!active_pair(body_system, pair)) continue;
+        if (overlap_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD)) {
+            // if the pair has been translated closer and intersect, they interpenetrate
+            return PENETRATING;
+        }
 
-            if (inner.intersect) {
-                // if the pair has been translated closer and intersect, they interpenetrate
-                return PENETRATING;
-            }
+        if (!overlap_pair(body_system, pair, +Engine::DISTANCE_THRESHOLD)) {
+            // if the pair has been translated away from each other and do not intersect,
+            // they do not have any contact
+            continue;
+        }
 
-            Collision::IntersectResult outer = Collision::intersect(
-                    &body_system->bodies[i], &body_system->bodies[j], +Engine::DISTANCE_THRESHOLD);
-            if (!outer.intersect) {
-                // if the pair has been translated away from each other and do not intersect,
-                // they do not have any contact
-                continue;
-            }
+        // only now the separating plane is needed
+        Collision::IntersectResult inner = intersect_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD);
+        if (inner.intersect) {
+            // no separating plane is found, see {penetrating_pair}
+            return PENETRATING;
+        }
+
+        std::vector<Contact *> this_contacts = ContactDerivation::get_contacts(&inner);
+        for (auto &this_contact : this_contacts) {
+            // find velocity if it is between small and large
+            glm::dvec3 padot = this_contact->body_a->point_velocity(this_contact->p);
+            glm::dvec3 pbdot = this_contact->body_b->point_velocity(this_contact->p);
 
-            std::vector<Contact *> this_contacts = ContactDerivation::get_contacts(&inner);
-            for (auto &this_contact : this_contacts) {
-                // find velocity if it is between small and large
-                glm::dvec3 padot = this_contact->body_a->point_velocity(this_contact->p);
-                glm::dvec3 pbdot = this_contact->body_b->point_velocity(this_contact->p);
-
-                // find relative velocity
-                double vrel = glm::dot(this_contact->n, padot - pbdot);
-                if (vrel < Engine::COLLISION_THRESHOLD) {
-                    return_state = CONTACT_RESTING_OR_COLLIDING;
-                } else {
-                    if (return_state != CONTACT_RESTING_OR_COLLIDING) {
-                        return_state = CONTACT_SEPARATING;
-                    }
+            // find relative velocity
+            double vrel = glm::dot(this_contact->n, padot - pbdot);
+            if (vrel < Engine::COLLISION_THRESHOLD) {
+                return_state = CONTACT_RESTING_OR_COLLIDING;
+            } else {
+                if (return_state != CONTACT_RESTING_OR_COLLIDING) {
+                    return_state = CONTACT_SEPARATING;
                 }
             }
         }
@@ -66,29 +127,28 @@ CollisionState CollisionDetection::find_collision_state(BodySystem *body_system)
 std::vector<Contact *> CollisionDetection::find_all_contacts(BodySystem *body_system)
 {
     std::vector<Contact *> all_contacts;
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        for (uint32_t j = i + 1; j < body_system->bodies.size(); j++) {
-            Collision::IntersectResult inner = Collision::intersect(
-                    &body_system->bodies[i], &body_system->bodies[j], -Engine::DISTANCE_THRESHOLD);
-
-            if (inner.intersect) {
-                // penetration should not happen
-                assert(0);
-            }
+    body_system->broadphase->update(body_system->bodies);
+    for (auto &pair : body_system->broadphase->get_pairs()) {
+        if (!active_pair(body_system, pair)) continue;
+        if (overlap_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD)) {
+            // penetration should not happen
+            assert(0);
+        }
 
-            Collision::IntersectResult outer = Collision::intersect(
-                    &body_system->bodies[i], &body_system->bodies[j], +Engine::DISTANCE_THRESHOLD);
-            if (!outer.intersect) {
-                // bodies are not in contact
-                continue;
-            }
+        if (!overlap_pair(body_system, pair, +Engine::DISTANCE_THRESHOLD)) {
+            // bodies are not in contact
+            continue;
+        }
 
-            std::vector<Contact *> contacts = ContactDerivation::get_contacts(&inner);
-            for (auto &this_contact : contacts) {
-                all_contacts.emplace_back(this_contact);
-            }
+        Collision::IntersectResult inner = intersect_pair(body_system, pair, -Engine::DISTANCE_THRESHOLD);
+        std::vector<Contact *> contacts = ContactDerivation::get_contacts(&inner);
+        for (auto &this_contact : contacts) {
+            all_contacts.emplace_back(this_contact);
         }
     }
 
+    // carry over the forces of the previous step
+    body_system->manifold_cache->match(all_contacts, body_system->bodies);
+
     return all_contacts;
 }
\ No newline at end of file
@@ -17,9 +17,17 @@ class Contact;
  * High-level routines that use the ones in {Collision} to determine the state of the simulation
  * as well as prevent collisions. */
 namespace CollisionDetection {
+    /**
+     * Whether {body} is moved in the current step, which is if it is active and not finished. Pairs of which
+     * neither body is moving are not tested. */
+    bool is_moving(const RigidBody *body);
+
     /** Returns true if at least one intersection. */
     bool intersect(BodySystem *body_system);
 
+    /** Returns the pairs of body indices which interpenetrate, as {intersect} would find them. */
+    std::vector<std::pair<uint32_t, uint32_t>> find_penetrating_pairs(BodySystem *body_system);
+
     /** Returns the state of the simulation. */
     CollisionState find_collision_state(BodySystem *body_system);
 
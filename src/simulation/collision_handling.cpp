@@ -1,4 +1,20 @@
 #include "collision_handling.hpp"
+#include "collision_detection.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * Inverse mass of {body} in the response to contacts, which is zero if it is not moved in the current substep, see
+ * {CollisionDetection::is_moving}. A finished body keeps its place until the end of the step, as if immovable. */
+double get_inv_mass(const RigidBody *body)
+{
+    return CollisionDetection::is_moving(body) ? body->shape->get_inv_mass() : 0.;
+}
+
+/** Inverse inertia tensor of {body} in the response to contacts, which is zero if it is not moved, as {get_inv_mass}. */
+glm::dmat3 get_i_inv(const RigidBody *body)
+{
+    return CollisionDetection::is_moving(body) ? body->i_inv : glm::dmat3(0.);
+}
 
 void CollisionHandling::collision(Contact *contact, double epsilon)
 {
@@ -11,25 +27,27 @@ void CollisionHandling::collision(Contact *contact, double epsilon)
     double vrel = glm::dot(n, padot - pbdot); // v^{line}_{rel}
     double numerator = -(1. + epsilon) * vrel;
 
-    double term1 = contact->body_a->shape->get_inv_mass();
-    double term2 = contact->body_b->shape->get_inv_mass();
-    double term3 = glm::dot(n, glm::cross(contact->body_a->i_inv * glm::cross(ra, n), ra));
-    double term4 = glm::dot(n, glm::cross(contact->body_b->i_inv * glm::cross(rb, n), rb));
+    double term1 = get_inv_mass(contact->body_a);
+    double term2 = get_inv_mass(contact->body_b);
+    double term3 = glm::dot(n, glm::cross(get_i_inv(contact->body_a) * glm::cross(ra, n), ra));
+    double term4 = glm::dot(n, glm::cross(get_i_inv(contact->body_b) * glm::cross(rb, n), rb));
 
     double impulse_magnitude = numerator / (term1 + term2 + term3 + term4);
     glm::dvec3 impulse = impulse_magnitude * n;
 
-    // add the impulse to contact objects
-    contact->body_a->p += impulse;
-    contact->body_b->p -= impulse;
-    contact->body_a->l += glm::cross(ra, impulse);
-    contact->body_b->l -= glm::cross(rb, impulse);
-
-    // recompute auxiliary quantities
-    contact->body_a->v = contact->body_a->p * contact->body_a->shape->get_inv_mass();
-    contact->body_b->v = contact->body_b->p * contact->body_b->shape->get_inv_mass();
-    contact->body_a->omega = contact->body_a->i_inv * contact->body_a->l;
-    contact->body_b->omega = contact->body_b->i_inv * contact->body_b->l;
+    // add the impulse to contact objects which are moved, and recompute their auxiliary quantities
+    if (CollisionDetection::is_moving(contact->body_a)) {
+        contact->body_a->p += impulse;
+        contact->body_a->l += glm::cross(ra, impulse);
+        contact->body_a->v = contact->body_a->p * contact->body_a->shape->get_inv_mass();
+        contact->body_a->omega = contact->body_a->i_inv * contact->body_a->l;
+    }
+    if (CollisionDetection::is_moving(contact->body_b)) {
+        contact->body_b->p -= impulse;
+        contact->body_b->l -= glm::cross(rb, impulse);
+        contact->body_b->v = contact->body_b->p * contact->body_b->shape->get_inv_mass();
+        contact->body_b->omega = contact->body_b->i_inv * contact->body_b->l;
+    }
 }
 
 bool CollisionHandling::find_all_collisions(std::vector<Contact *> contacts)
@@ -43,8 +61,10 @@ bool CollisionHandling::find_all_collisions(std::vector<Contact *> contacts)
 
         if (vrel > Engine::COLLISION_THRESHOLD) {
             // moving away: do nothing
-        } else if (vrel < -Engine::COLLISION_THRESHOLD) {
-            // interpenetration: find impulse
+        } else if (vrel < -Engine::COLLISION_THRESHOLD ||
+                   (vrel < 0. && contact->distance() < -Engine::WARNING_DISTANCE_THRESHOLD)) {
+            // interpenetration: find impulse. a resting contact which is nearly interpenetrating and still
+            // approaches would soon be deeper than {Engine::DISTANCE_THRESHOLD}, so it is stopped as well
             collision(contact, EPSILON);
             return true;
         } else { // if (vrel >= -Engine::COLLISION_THRESHOLD && vrel <= Engine::COLLISION_THRESHOLD)
@@ -71,8 +91,16 @@ glm::dvec3 CollisionHandling::compute_ndot(Contact *c)
     }
 }
 
-void CollisionHandling::compute_b_vector(double *bvec, std::vector<Contact *> contacts)
+/** Index of {body} in {BodySystem::body_state}, or -1 if it is not integrated. */
+int32_t get_slot(const BodySystem *body_system, const RigidBody *body)
+{
+    return body_system->body_state.slot[body - body_system->bodies.data()];
+}
+
+void CollisionHandling::compute_b_vector(
+        const BodySystem *body_system, double *bvec, const std::vector<Contact *> &contacts)
 {
+    const BodyState &state = body_system->body_state;
     for (uint32_t i = 0; i < contacts.size(); i++) {
         Contact *c = contacts[i];
         RigidBody *a = c->body_a;
@@ -81,21 +109,29 @@ void CollisionHandling::compute_b_vector(double *bvec, std::vector<Contact *> co
         glm::dvec3 ra = c->p - a->x;
         glm::dvec3 rb = c->p - b->x;
 
-        // get the external forces and torques
-        glm::dvec3 f_ext_a = a->force;
-        glm::dvec3 f_ext_b = b->force;
-        glm::dvec3 t_ext_a = a->torque;
-        glm::dvec3 t_ext_b = b->torque;
+        // get the external forces and torques, which are zero for bodies which are not integrated
+        int32_t slot_a = get_slot(body_system, a);
+        int32_t slot_b = get_slot(body_system, b);
+        glm::dvec3 f_ext_a = slot_a < 0 ? glm::dvec3(0.) : state.force[slot_a];
+        glm::dvec3 f_ext_b = slot_b < 0 ? glm::dvec3(0.) : state.force[slot_b];
+        glm::dvec3 t_ext_a = slot_a < 0 ? glm::dvec3(0.) : state.torque[slot_a];
+        glm::dvec3 t_ext_b = slot_b < 0 ? glm::dvec3(0.) : state.torque[slot_b];
 
         // compute the part due to the external force and torque
-        glm::dvec3 a_ext_part = f_ext_a * a->shape->get_inv_mass() + glm::cross(a->i_inv * t_ext_a, ra);
-        glm::dvec3 b_ext_part = f_ext_b * b->shape->get_inv_mass() + glm::cross(b->i_inv * t_ext_b, rb);
-
-        // compute the part due to velocity
-        glm::dvec3 a_vel_part = glm::cross(a->omega, glm::cross(a->omega, ra)) +
-                                glm::cross(a->i_inv * glm::cross(a->l, a->omega), ra);
-        glm::dvec3 b_vel_part = glm::cross(b->omega, glm::cross(b->omega, rb)) +
-                                glm::cross(b->i_inv * glm::cross(b->l, b->omega), rb);
+        glm::dvec3 a_ext_part = f_ext_a * get_inv_mass(a) + glm::cross(get_i_inv(a) * t_ext_a, ra);
+        glm::dvec3 b_ext_part = f_ext_b * get_inv_mass(b) + glm::cross(get_i_inv(b) * t_ext_b, rb);
+
+        // compute the part due to velocity, a body which is not moved is not accelerated
+        glm::dvec3 a_vel_part = glm::dvec3(0.);
+        glm::dvec3 b_vel_part = glm::dvec3(0.);
+        if (CollisionDetection::is_moving(a)) {
+            a_vel_part = glm::cross(a->omega, glm::cross(a->omega, ra)) +
+                         glm::cross(a->i_inv * glm::cross(a->l, a->omega), ra);
+        }
+        if (CollisionDetection::is_moving(b)) {
+            b_vel_part = glm::cross(b->omega, glm::cross(b->omega, rb)) +
+                         glm::cross(b->i_inv * glm::cross(b->l, b->omega), rb);
+        }
 
         // combine the above results
         double k1 = glm::dot(n, (a_ext_part + a_vel_part) - (b_ext_part + b_vel_part));
@@ -146,11 +182,11 @@ double CollisionHandling::compute_aij(Contact *ci, Contact *cj)
     }
 
     // compute how the jth contact force affects the linear and angular acceleration of the contact point on body a
-    glm::dvec3 a_linear = force_on_a * a->shape->get_inv_mass();
-    glm::dvec3 a_angular = glm::cross(a->i_inv * torque_on_a, ra);
+    glm::dvec3 a_linear = force_on_a * get_inv_mass(a);
+    glm::dvec3 a_angular = glm::cross(get_i_inv(a) * torque_on_a, ra);
 
-    glm::dvec3 b_linear = force_on_b * b->shape->get_inv_mass();
-    glm::dvec3 b_angular = glm::cross(b->i_inv * torque_on_b, rb);
+    glm::dvec3 b_linear = force_on_b * get_inv_mass(b);
+    glm::dvec3 b_angular = glm::cross(get_i_inv(b) * torque_on_b, rb);
 
     return glm::dot(ni, (a_linear + a_angular) - (b_linear + b_angular));
 }
@@ -169,7 +205,109 @@ void CollisionHandling::compute_a_matrix(double *amat, std::vector<Contact *> co
     }
 }
 
-void CollisionHandling::compute_contact_forces(std::vector<Contact *> contacts)
+void CollisionHandling::compute_a_matrix(
+        math::SparseMatrix *amat, const std::vector<Contact *> &contacts, math::SolverWorkspace *workspace)
+{
+    // the contacts of every movable body, sorted by body and then by index. a body with zero inverse mass, or which
+    // is not moved, is not accelerated by any contact force, so contacts which only share such a body do not
+    // influence each other
+    std::vector<std::pair<const void *, uint32_t>> &body_contacts = workspace->body_contacts;
+    body_contacts.clear();
+    for (uint32_t i = 0; i < contacts.size(); i++) {
+        if (get_inv_mass(contacts[i]->body_a) != 0.) body_contacts.emplace_back(contacts[i]->body_a, i);
+        if (get_inv_mass(contacts[i]->body_b) != 0.) body_contacts.emplace_back(contacts[i]->body_b, i);
+    }
+    std::sort(body_contacts.begin(), body_contacts.end());
+
+    amat->n = contacts.size();
+    amat->row_start.assign(1, 0);
+    amat->columns.clear();
+    amat->values.clear();
+
+    std::vector<uint32_t> &row = workspace->columns;
+    for (uint32_t i = 0; i < contacts.size(); i++) {
+        // the contacts sharing a movable body with contact i, including itself
+        row.assign(1, i);
+        for (const void *body : {(const void *) contacts[i]->body_a, (const void *) contacts[i]->body_b}) {
+            auto it = std::lower_bound(body_contacts.begin(), body_contacts.end(), std::make_pair(body, 0u));
+            for (; it != body_contacts.end() && it->first == body; it++) {
+                row.emplace_back(it->second);
+            }
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+
+        for (uint32_t j : row) {
+            // the upper triangle is computed as in the dense matrix, the lower triangle is mirrored from it
+            amat->columns.emplace_back(j);
+            amat->values.emplace_back(j < i ? amat->get(j, i) : compute_aij(contacts[i], contacts[j]));
+        }
+        amat->row_start.emplace_back(amat->columns.size());
+    }
+}
+
+uint32_t CollisionHandling::solve_contact_forces(
+        const BodySystem *body_system, const std::vector<Contact *> &resting_contacts,
+        math::SolverWorkspace *workspace)
+{
+    std::array<size_t, math::SolverWorkspace::BUFFERS> capacities = workspace->get_capacities();
+
+    workspace->bvec.resize(resting_contacts.size());
+    double *bvec = workspace->bvec.data();
+    compute_b_vector(body_system, bvec, resting_contacts);
+
+    compute_a_matrix(&workspace->amat, resting_contacts, workspace);
+
+    // start from the forces of the previous step
+    workspace->fvec.resize(resting_contacts.size());
+    double *fvec = workspace->fvec.data();
+    for (uint32_t i = 0; i < resting_contacts.size(); i++) {
+        fvec[i] = resting_contacts[i]->force;
+    }
+    uint32_t pivots = 0;
+    if (body_system->contact_solver_type == DANTZIG) {
+        pivots = math::qp_solve(workspace->amat, bvec, fvec, resting_contacts.size(), workspace);
+    } else {
+        math::pgs_solve(workspace->amat, bvec, fvec, resting_contacts.size(), body_system->pgs_max_iterations,
+                        body_system->pgs_tolerance, workspace);
+    }
+
+    for (uint32_t i = 0; i < resting_contacts.size(); i++) {
+        // force may be very slightly smaller than zero due to the threshold used in qp_solve
+        if (fvec[i] < 0.) {
+            fvec[i] = 0.;
+        }
+        resting_contacts[i]->force = fvec[i];
+    }
+
+    workspace->count_allocations(capacities);
+    return pivots;
+}
+
+/**
+ * Adds the solved forces of {resting_contacts} to the force and torque of their bodies in {BodySystem::body_state},
+ * in order. Bodies which are not integrated are left out. */
+void apply_contact_forces(BodySystem *body_system, const std::vector<Contact *> &resting_contacts)
+{
+    BodyState &state = body_system->body_state;
+    for (auto &contact : resting_contacts) {
+        glm::dvec3 force = contact->force * contact->n;
+
+        int32_t slot_a = get_slot(body_system, contact->body_a);
+        if (slot_a >= 0) {
+            state.force[slot_a] += force;
+            state.torque[slot_a] += glm::cross(contact->p - contact->body_a->x, force);
+        }
+
+        int32_t slot_b = get_slot(body_system, contact->body_b);
+        if (slot_b >= 0) {
+            state.force[slot_b] -= force;
+            state.torque[slot_b] -= glm::cross(contact->p - contact->body_b->x, force);
+        }
+    }
+}
+
+uint32_t CollisionHandling::compute_contact_forces(BodySystem *body_system, std::vector<Contact *> contacts)
 {
     /** identify all resting contacts */
     std::vector<Contact *> resting_contacts;
@@ -180,6 +318,7 @@ void CollisionHandling::compute_contact_forces(std::vector<Contact *> contacts)
 
         if (vrel > Engine::COLLISION_THRESHOLD) {
             // moving away: do nothing
+            contacts[i]->force = 0.;
         } else if (vrel < -Engine::COLLISION_THRESHOLD) {
             // interpenetration: already been handled
             assert(0);
@@ -188,38 +327,31 @@ void CollisionHandling::compute_contact_forces(std::vector<Contact *> contacts)
         }
     }
 
-    if (resting_contacts.empty()) return;
+    if (resting_contacts.empty()) return 0;
 
-    /** solve all resting contacts */
-    auto bvec = (double *) malloc(resting_contacts.size() * sizeof(double));
-    compute_b_vector(bvec, resting_contacts);
-
-    auto amat = (double *) malloc(resting_contacts.size() * resting_contacts.size() * sizeof(double));
-    compute_a_matrix(amat, resting_contacts);
-
-    auto fvec = (double *) malloc(resting_contacts.size() * sizeof(double));
-    math::qp_solve(amat, bvec, fvec, resting_contacts.size());
-
-    /** scatter the forces */
-    for (uint32_t i = 0; i < resting_contacts.size(); i++) {
-        // force may be very slightly smaller than zero due to the threshold used in qp_solve
-        if (fvec[i] < 0.) {
-            fvec[i] = 0.;
-        }
-        glm::dvec3 force = fvec[i] * resting_contacts[i]->n;
-
-        resting_contacts[i]->body_a->force += force;
-        resting_contacts[i]->body_b->force -= force;
+    if (!body_system->use_islands) {
+        uint32_t pivots = solve_contact_forces(body_system, resting_contacts, &body_system->solver_workspaces[0]);
+        apply_contact_forces(body_system, resting_contacts);
+        return pivots;
+    }
 
-        resting_contacts[i]->body_a->torque += glm::cross(
-                resting_contacts[i]->p - resting_contacts[i]->body_a->x, force);
-        resting_contacts[i]->body_b->torque -= glm::cross(
-                resting_contacts[i]->p - resting_contacts[i]->body_b->x, force);
+    /** solve every island of resting contacts separately and concurrently */
+    std::vector<std::vector<Contact *>> islands = Island::find_islands(resting_contacts, body_system->bodies);
+    std::vector<uint32_t> island_pivots(islands.size());
+    body_system->thread_pool->parallel_for(islands.size(), [&](uint32_t i, uint32_t thread) {
+        island_pivots[i] = solve_contact_forces(body_system, islands[i], &body_system->solver_workspaces[thread]);
+    });
+
+    /** scatter the forces, in the order of the islands such that the result does not depend on the threads */
+    body_system->island_statistics.calls++;
+    uint32_t pivots = 0;
+    for (uint32_t i = 0; i < islands.size(); i++) {
+        body_system->island_statistics.add(islands[i].size());
+        apply_contact_forces(body_system, islands[i]);
+        pivots += island_pivots[i];
     }
 
-    free(fvec);
-    free(amat);
-    free(bvec);
+    return pivots;
 }
 
 void CollisionHandling::correct_state(BodySystem *body_system)
@@ -262,14 +394,13 @@ void CollisionHandling::correct_state(BodySystem *body_system)
 
     for (auto &body : body_system->bodies) {
         body.x += body.force * body.shape->get_inv_mass();
-        body.a += Integrator::star(body.i_inv * body.torque) * body.a;
-
-        // todo use a quaternion
-        body.a = glm::orthonormalize(body.a);
+        body.q += Integrator::spin(body.i_inv * body.torque, body.q);
+        body.q = glm::normalize(body.q);
 
 //        // compute auxiliary quantities
 //        body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
+        glm::dmat3 a = body.get_rotation();
+        body.i_inv = a * body.shape->get_inv_moment_of_inertia() * glm::transpose(a);
         body.omega = body.i_inv * body.l;
     }
 }
\ No newline at end of file
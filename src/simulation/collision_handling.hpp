@@ -3,6 +3,7 @@
 
 #include "contact.hpp"
 #include "integrator.hpp"
+#include "math.hpp"
 
 /**
  * Routines that compute and apply the required response to handle collisions. */
@@ -33,8 +34,9 @@ namespace CollisionHandling {
 
     /**
      * Computes the contribution of the external force and inertial forces due to velocity of the contacts.
+     * The external forces are read from {BodySystem::body_state}, see {Integrator::apply_forces}.
      * Equal in function to "compute_b_vector" of Ref. 1. */
-    void compute_b_vector(double *bvec, std::vector<Contact *> contacts);
+    void compute_b_vector(const BodySystem *body_system, double *bvec, const std::vector<Contact *> &contacts);
 
     /**
      * Computes the value of matrix A for pair of contacts {ci} and {cj}.
@@ -46,8 +48,29 @@ namespace CollisionHandling {
      * Equal in function to "compute_a_matrix" of Ref. 1. */
     void compute_a_matrix(double *amat, std::vector<Contact *> contacts);
 
-    /** finds resting contacts and prevents penetration */
-    void compute_contact_forces(std::vector<Contact *> contacts);
+    /**
+     * {compute_a_matrix} in sparse form. Only the pairs of contacts which share a movable body are evaluated, as
+     * all other entries are zero, such that the cost is linear in the number of contacts if no body has many.
+     * The scratch buffers of {workspace} are used, and {amat} reuses its storage. */
+    void compute_a_matrix(
+            math::SparseMatrix *amat, const std::vector<Contact *> &contacts, math::SolverWorkspace *workspace);
+
+    /**
+     * Solves the forces of {resting_contacts} in {workspace} with {BodySystem::contact_solver_type}, without
+     * applying them to the bodies. {Contact::force} is used as initial guess and set to the solved force. As only
+     * {Contact::force} is written, separate sets of contacts can be solved concurrently with separate workspaces.
+     * Returns the number of pivots, which is zero for the iterative solver. */
+    uint32_t solve_contact_forces(
+            const BodySystem *body_system, const std::vector<Contact *> &resting_contacts,
+            math::SolverWorkspace *workspace);
+
+    /**
+     * finds resting contacts and prevents penetration
+     * {Contact::force} is used as initial guess and set to the solved force. Unless {BodySystem::use_islands} is
+     * false, the contacts are split into islands which are solved concurrently on {BodySystem::thread_pool}, each
+     * thread using its own {BodySystem::solver_workspaces}. The forces are added to {BodySystem::body_state}, in the
+     * same order regardless of the number of threads. Returns the number of pivots. */
+    uint32_t compute_contact_forces(BodySystem *body_system, std::vector<Contact *> contacts);
 
     /*
      * Correction computation and application.
@@ -1,9 +1,27 @@
 #include "contact.hpp"
 
+uint32_t Feature::vertex(uint32_t i)
+{
+    return i;
+}
+
+uint32_t Feature::edge(uint32_t i)
+{
+    if (i == NONE) return NONE;
+    return 1u << 30u | i;
+}
+
+uint32_t Feature::face(uint32_t i)
+{
+    return 2u << 30u | i;
+}
+
 Contact::Contact(
-        glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb
+        glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb,
+        uint32_t p_feature_a, uint32_t p_feature_b
 ) :
-        p(p_p), n(p_n), body_a(p_body_a), body_b(p_body_b), pb(p_pb)
+        p(p_p), n(p_n), body_a(p_body_a), body_b(p_body_b), pb(p_pb), feature_a(p_feature_a),
+        feature_b(p_feature_b)
 {
     vf = true;
     if (glm::dot(p_p - p_body_b->x, p_n) < 0) {
@@ -14,9 +32,9 @@ Contact::Contact(
 
 Contact::Contact(
         glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb,
-        glm::dvec3 p_ea, glm::dvec3 p_eb
+        glm::dvec3 p_ea, glm::dvec3 p_eb, uint32_t p_feature_a, uint32_t p_feature_b
 ) :
-        Contact(p_p, p_n, p_body_a, p_body_b, p_pb)
+        Contact(p_p, p_n, p_body_a, p_body_b, p_pb, p_feature_a, p_feature_b)
 {
     vf = false;
     ea = p_ea;
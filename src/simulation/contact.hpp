@@ -6,6 +6,20 @@
 
 class RigidBody;
 
+/**
+ * Identifies a vertex, edge or face of the shape of a body by its index, tagged with its type, such that contacts
+ * can be matched across steps by the features that form them. */
+namespace Feature {
+    /** Not a feature, for instance when an edge is looked up between vertices which share none. */
+    const uint32_t NONE = UINT32_MAX;
+
+    uint32_t vertex(uint32_t i);
+
+    uint32_t edge(uint32_t i);
+
+    uint32_t face(uint32_t i);
+}
+
 class Contact {
 public:
     /** Point of contact, which always lies on {body_a}. */
@@ -37,12 +51,24 @@ public:
     /** True if contact is formed by vertex-face interaction. */
     bool vf;
 
+    /** Feature of {body_a} forming the contact, see {Feature}. If {vf}, the vertex, if not, the edge. */
+    uint32_t feature_a;
+
+    /** Feature of {body_b} forming the contact, see {Feature}. If {vf}, the face, if not, the edge. */
+    uint32_t feature_b;
+
+    /**
+     * Magnitude of the contact force. Before it is solved, the force solved for the same contact in the previous
+     * step, which is used as initial guess. */
+    double force = 0.;
+
     Contact(
-            glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb);
+            glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb,
+            uint32_t p_feature_a, uint32_t p_feature_b);
 
     Contact(
             glm::dvec3 p_p, glm::dvec3 p_n, RigidBody *p_body_a, RigidBody *p_body_b, glm::dvec3 p_pb,
-            glm::dvec3 p_ea, glm::dvec3 p_eb);
+            glm::dvec3 p_ea, glm::dvec3 p_eb, uint32_t p_feature_a, uint32_t p_feature_b);
 
     /** Returns the distance from {p} to {body_b}. */
     double distance() const;
@@ -170,7 +170,9 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
             glm::dvec3 x = glm::normalize(ea2 - ea1);
             glm::dvec3 v = ea2 - x * (dist_ea2 / glm::dot(x, m));
             glm::dvec3 pb = result->b->get_world_space_vertex(result->b->shape->get_edges()[result->ebi].first);
-            contacts.emplace_back(new Contact(v, result->n, result->a, result->b, pb, result->ea, result->eb));
+            contacts.emplace_back(new Contact(
+                    v, result->n, result->a, result->b, pb, result->ea, result->eb,
+                    Feature::edge(index), Feature::edge(result->ebi)));
         }
     } else {
         // plane formed by face of b, against edge of A
@@ -184,13 +186,17 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
         glm::dvec3 p1;         // first intersection point
         bool p1_found = false; // whether the first intersection has been found
         glm::dvec3 eb_one;     // unitized direction of the first edge that is intersected
+        uint32_t eb_one_i{};   // index of the first edge that is intersected
         glm::dvec3 p2;         // second intersection point
         bool p2_found = false; // whether the second intersection has been found
         glm::dvec3 eb_two;     // unitized direction of the second edge that is intersected
+        uint32_t eb_two_i{};   // index of the second edge that is intersected
 
-        glm::dvec3 eb1 = result->b->get_world_space_vertex(result->b->shape->get_faces()[result->fbi].back().first);
+        uint32_t vb1 = result->b->shape->get_faces()[result->fbi].back().first;
+        glm::dvec3 eb1 = result->b->get_world_space_vertex(vb1);
         for (uint32_t i = 0; i < result->b->shape->get_faces()[result->fbi].size(); i++) {
-            glm::dvec3 eb2 = result->b->get_world_space_vertex(result->b->shape->get_faces()[result->fbi][i].first);
+            uint32_t vb2 = result->b->shape->get_faces()[result->fbi][i].first;
+            glm::dvec3 eb2 = result->b->get_world_space_vertex(vb2);
 
             glm::dvec3 p;
             if (test(&p, eb1, eb2, result->n, ea1, ea2)) {
@@ -199,6 +205,7 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
                     p1 = p;
                     p1_found = true;
                     eb_one = glm::normalize(eb2 - eb1);
+                    eb_one_i = result->b->shape->find_edge(vb1, vb2);
                 } else {
                     if (p2_found) {
                         assert(0); // an edge and a convex face cannot cause more than two intersections
@@ -206,18 +213,26 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
                     p2 = p;
                     p2_found = true;
                     eb_two = glm::normalize(eb2 - eb1);
+                    eb_two_i = result->b->shape->find_edge(vb1, vb2);
                 }
             }
 
+            vb1 = vb2;
             eb1 = eb2;
         }
 
+        // the features of the contacts
+        uint32_t fa = Feature::edge(index);
+        uint32_t fa1 = Feature::vertex(result->a->shape->get_edges()[index].first);
+        uint32_t fa2 = Feature::vertex(result->a->shape->get_edges()[index].second);
+        uint32_t fb = Feature::face(result->fbi);
+
         /** four cases */
         if (ea1_inside && ea2_inside) {
             // edge is fully contained by face, create two vertex-face contacts
             assert(!p1_found && !p2_found);
-            contacts.emplace_back(new Contact(ea1, result->n, result->a, result->b, eb1));
-            contacts.emplace_back(new Contact(ea2, result->n, result->a, result->b, eb1));
+            contacts.emplace_back(new Contact(ea1, result->n, result->a, result->b, eb1, fa1, fb));
+            contacts.emplace_back(new Contact(ea2, result->n, result->a, result->b, eb1, fa2, fb));
         } else if (ea1_inside != ea2_inside) {
             // one point of edge is contained by face, the other is not, create one vertex-face and one edge-edge contact
             assert(p1_found && !p2_found);
@@ -230,12 +245,13 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
             }
 
             // create the contacts
+            uint32_t fb_one = Feature::edge(eb_one_i);
             if (ea1_inside) {
-                contacts.emplace_back(new Contact(ea1, result->n, result->a, result->b, eb1));
-                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, eb1, ea, eb_one));
+                contacts.emplace_back(new Contact(ea1, result->n, result->a, result->b, eb1, fa1, fb));
+                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, eb1, ea, eb_one, fa, fb_one));
             } else { // if (eb2_inside)
-                contacts.emplace_back(new Contact(ea2, result->n, result->a, result->b, eb1));
-                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, eb1, ea, eb_one));
+                contacts.emplace_back(new Contact(ea2, result->n, result->a, result->b, eb1, fa2, fb));
+                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, eb1, ea, eb_one, fa, fb_one));
             }
         } else if (!ea1_inside && !ea2_inside && p1_found && p2_found) {
             // endpoints of edge are outside face, but intersect at two points
@@ -251,8 +267,10 @@ std::vector<Contact *> ContactDerivation::get_contacts_edge(Collision::Intersect
                 n2 = glm::normalize(glm::cross(ea, eb_two));
             }
 
-            contacts.emplace_back(new Contact(p1, n1, result->a, result->b, eb1, ea, eb_one));
-            contacts.emplace_back(new Contact(p2, n2, result->a, result->b, eb1, ea, eb_two));
+            contacts.emplace_back(new Contact(
+                    p1, n1, result->a, result->b, eb1, ea, eb_one, fa, Feature::edge(eb_one_i)));
+            contacts.emplace_back(new Contact(
+                    p2, n2, result->a, result->b, eb1, ea, eb_two, fa, Feature::edge(eb_two_i)));
         } else if (!ea1_inside && !ea2_inside && !p1_found && !p2_found) {
             // endpoints of edge are outside face, but intersect at no points
             // if this happens, no contact points should be generated
@@ -278,7 +296,8 @@ std::vector<Contact *> ContactDerivation::get_contacts_vertex(Collision::Interse
         if (inside(result->b, result->a, result->fbi, index)) {
             glm::dvec3 pb = result->b->get_world_space_vertex(result->b->shape->get_edges()[result->ebi].first);
             glm::dvec3 p = result->a->get_world_space_vertex(index);
-            contacts.emplace_back(new Contact(p, result->n, result->a, result->b, pb));
+            contacts.emplace_back(new Contact(
+                    p, result->n, result->a, result->b, pb, Feature::vertex(index), Feature::face(result->fbi)));
         }
     }
 
@@ -338,14 +357,17 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
         glm::dvec3 p1;          // first intersection point
         bool p1_found = false;  // whether the first intersection has been found
         glm::dvec3 ea_one;      // unitized direction of the first edge that is intersected
+        uint32_t ea_one_i{};    // index of the first edge that is intersected
         glm::dvec3 p2;          // second intersection point
         bool p2_found = false;  // whether the second intersection has been found
         glm::dvec3 ea_two;      // unitized direction of the first edge that is intersected
+        uint32_t ea_two_i{};    // index of the second edge that is intersected
 
         // if we first need to check whether a point is within distance from the separating plane,
         // ea1 is the last point which is within distance (instead of simply the last point)
         // this construction works since we know that at least three points are available (else we would be in the edge case)
         glm::dvec3 ea1;
+        uint32_t va1 = Feature::NONE;
         if (check_distance) {
             ea1 = glm::dvec3(0.);
             uint32_t n = result->a->shape->get_faces()[fai].size();
@@ -353,14 +375,17 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                 glm::dvec3 v = result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][n - 1 - i].first);
                 if (fabs(result->dist(v)) <= Engine::DISTANCE_THRESHOLD) {
                     ea1 = v;
+                    va1 = result->a->shape->get_faces()[fai][n - 1 - i].first;
                     break;
                 }
             }
         } else {
-            ea1 = result->a->get_world_space_vertex(result->a->shape->get_faces()[fai].back().first);
+            va1 = result->a->shape->get_faces()[fai].back().first;
+            ea1 = result->a->get_world_space_vertex(va1);
         }
         for (uint32_t i = 0; i < result->a->shape->get_faces()[fai].size(); i++) {
-            glm::dvec3 ea2 = result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][i].first);
+            uint32_t va2 = result->a->shape->get_faces()[fai][i].first;
+            glm::dvec3 ea2 = result->a->get_world_space_vertex(va2);
             // if ea2 is not within distance from the separating plane continue and do *not* update ea1
             if (check_distance && fabs(result->dist(ea2)) > Engine::DISTANCE_THRESHOLD) continue;
 
@@ -370,6 +395,7 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                     p1 = p;
                     p1_found = true;
                     ea_one = glm::normalize(ea2 - ea1);
+                    ea_one_i = result->a->shape->find_edge(va1, va2);
                 } else {
                     if (p2_found) {
                         assert(0); // an edge and a convex face cannot cause more than two intersections
@@ -377,17 +403,25 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                     p2 = p;
                     p2_found = true;
                     ea_two = glm::normalize(ea2 - ea1);
+                    ea_two_i = result->a->shape->find_edge(va1, va2);
                 }
             }
 
+            va1 = va2;
             ea1 = ea2;
         }
 
+        // the features of the contacts, for vertex-face contacts the bodies are swapped
+        uint32_t fa = Feature::face(fai);
+        uint32_t fb = Feature::edge(result->ebi);
+        uint32_t fb1 = Feature::vertex(result->b->shape->get_edges()[result->ebi].first);
+        uint32_t fb2 = Feature::vertex(result->b->shape->get_edges()[result->ebi].second);
+
         /** four cases */
         if (eb1_inside && eb2_inside) {
             assert(!p1_found && !p2_found);
-            contacts.emplace_back(new Contact(eb1, -result->n, result->b, result->a, ea1));
-            contacts.emplace_back(new Contact(eb2, -result->n, result->b, result->a, ea1));
+            contacts.emplace_back(new Contact(eb1, -result->n, result->b, result->a, ea1, fb1, fa));
+            contacts.emplace_back(new Contact(eb2, -result->n, result->b, result->a, ea1, fb2, fa));
         } else if (eb1_inside != eb2_inside) {
             // one point of edge is contained by face, the other is not, create one vertex-face and one edge-edge contact
             assert(p1_found && !p2_found);
@@ -399,12 +433,13 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                 n1 = glm::normalize(glm::cross(ea_one, eb));
             }
 
+            uint32_t fa_one = Feature::edge(ea_one_i);
             if (eb1_inside) {
-                contacts.emplace_back(new Contact(eb1, -result->n, result->b, result->a, ea1));
-                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, ea1, ea_one, eb));
+                contacts.emplace_back(new Contact(eb1, -result->n, result->b, result->a, ea1, fb1, fa));
+                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, ea1, ea_one, eb, fa_one, fb));
             } else { // if (eb2_inside)
-                contacts.emplace_back(new Contact(eb2, -result->n, result->b, result->a, ea1));
-                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, ea1, ea_one, eb));
+                contacts.emplace_back(new Contact(eb2, -result->n, result->b, result->a, ea1, fb2, fa));
+                contacts.emplace_back(new Contact(p1, n1, result->a, result->b, ea1, ea_one, eb, fa_one, fb));
             }
         } else if (!eb1_inside && !eb2_inside && p1_found && p2_found) {
             // endpoints of edge are outside face, but intersect at two points
@@ -420,8 +455,10 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                 n2 = glm::normalize(glm::cross(ea_two, eb));
             }
 
-            contacts.emplace_back(new Contact(p1, n1, result->a, result->b, ea1, ea_one, eb));
-            contacts.emplace_back(new Contact(p2, n2, result->a, result->b, ea1, ea_two, eb));
+            contacts.emplace_back(new Contact(
+                    p1, n1, result->a, result->b, ea1, ea_one, eb, Feature::edge(ea_one_i), fb));
+            contacts.emplace_back(new Contact(
+                    p2, n2, result->a, result->b, ea1, ea_two, eb, Feature::edge(ea_two_i), fb));
         } else if (!eb1_inside && !eb2_inside && !p1_found && !p2_found) {
             // endpoints of edge are outside face, but intersect at no points
             // if this happens, no contact points should be generated
@@ -470,10 +507,14 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
             glm::dvec3 ea_two;          // (unitized) edge direction of A of second intersection
             glm::dvec3 eb_two;          // (unitized) edge direction of B of second intersection
             glm::dvec3 n_two;           // normal outwards from B of first intersection
+            uint32_t fb_one{};          // feature of B of first intersection
+            uint32_t fb_two{};          // feature of B of second intersection
             uint32_t intersections = 0; // number of intersections
-            glm::dvec3 eb1 = result->b->get_world_space_vertex(result->b->shape->get_faces()[result->fbi].back().first);
+            uint32_t vb1 = result->b->shape->get_faces()[result->fbi].back().first;
+            glm::dvec3 eb1 = result->b->get_world_space_vertex(vb1);
             for (uint32_t j = 0; j < result->b->shape->get_faces()[result->fbi].size(); j++) {
-                glm::dvec3 eb2 = result->b->get_world_space_vertex(result->b->shape->get_faces()[result->fbi][j].first);
+                uint32_t vb2 = result->b->shape->get_faces()[result->fbi][j].first;
+                glm::dvec3 eb2 = result->b->get_world_space_vertex(vb2);
                 glm::dvec3 *p = intersections == 0 ? &p1 : &p2;
                 // NB: order of eb1 and eb2 matters
                 if (test(p, eb1, eb2, result->b->get_non_unit_normal(result->fbi), ea1, ea2)) {
@@ -485,6 +526,7 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                             ea_one *= -1;
                             n_one = glm::normalize(glm::cross(ea_one, eb_one));
                         }
+                        fb_one = Feature::edge(result->b->shape->find_edge(vb1, vb2));
                     } else {
                         ea_two = glm::normalize(ea1 - ea2);
                         eb_two = glm::normalize(eb1 - eb2);
@@ -493,37 +535,50 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                             ea_two *= -1;
                             n_two = glm::normalize(glm::cross(ea_two, eb_two));
                         }
+                        fb_two = Feature::edge(result->b->shape->find_edge(vb1, vb2));
                     }
                     intersections++;
                 }
+                vb1 = vb2;
                 eb1 = eb2;
             }
 
             assert(intersections < 3);
 
+            // the features of the contacts
+            uint32_t fa = Feature::edge(result->a->shape->find_edge(prev_va, this_va));
+            uint32_t fa_this = Feature::vertex(this_va);
+            uint32_t fb = Feature::face(result->fbi);
+
             /** interpret intersect results */
             if (!prev_va_inside && !this_va_inside) {
                 // add no endpoints, add the two intersection points if they exist
                 assert(intersections == 2 || intersections == 0);
                 if (intersections == 2) {
-                    contacts.emplace_back(new Contact(p1, n_one, result->a, result->b, eb1, ea_one, eb_one));
-                    contacts.emplace_back(new Contact(p2, n_two, result->a, result->b, eb1, ea_two, eb_two));
+                    contacts.emplace_back(new Contact(
+                            p1, n_one, result->a, result->b, eb1, ea_one, eb_one, fa, fb_one));
+                    contacts.emplace_back(new Contact(
+                            p2, n_two, result->a, result->b, eb1, ea_two, eb_two, fa, fb_two));
                 }
             } else if (!prev_va_inside && this_va_inside) {
                 // add current endpoint, and intersection
 //                assert(intersections == 1); // todo edges can be collinear: investigate if this can cause troubles (also in other places)
-                contacts.emplace_back(new Contact(p1, n_one, result->a, result->b, eb1, ea_one, eb_one));
-                contacts.emplace_back(
-                        new Contact(result->a->get_world_space_vertex(this_va), result->n, result->a, result->b, eb1));
+                contacts.emplace_back(new Contact(
+                        p1, n_one, result->a, result->b, eb1, ea_one, eb_one, fa, fb_one));
+                contacts.emplace_back(new Contact(
+                        result->a->get_world_space_vertex(this_va), result->n, result->a, result->b, eb1,
+                        fa_this, fb));
             } else if (prev_va_inside && !this_va_inside) {
                 // only add intersection
                 assert(intersections == 1);
-                contacts.emplace_back(new Contact(p1, n_one, result->a, result->b, eb1, ea_one, eb_one));
+                contacts.emplace_back(new Contact(
+                        p1, n_one, result->a, result->b, eb1, ea_one, eb_one, fa, fb_one));
             } else { // if (prev_inside && this_inside)
                 // only add current endpoint
 //                assert(intersections == 0); // todo collinearity issue: see todo above
-                contacts.emplace_back(
-                        new Contact(result->a->get_world_space_vertex(this_va), result->n, result->a, result->b, eb1));
+                contacts.emplace_back(new Contact(
+                        result->a->get_world_space_vertex(this_va), result->n, result->a, result->b, eb1,
+                        fa_this, fb));
             }
 
             prev_va_inside = this_va_inside;
@@ -532,7 +587,7 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
 
         /** now do the same from Bs POV, and do not add intersections */
 
-        glm::dvec3 fbn = glm::normalize(result->b->get_non_unit_normal(result->fbi));
+        glm::dvec3 fbn = result->b->get_unit_normal(result->fbi);
         uint32_t prev_vb = result->b->shape->get_faces()[result->fbi].back().first;
         bool prev_vb_inside;
         if (check_distance) {
@@ -556,18 +611,20 @@ std::vector<Contact *> ContactDerivation::get_contacts_face(
                 // add current endpoint, and intersection
                 contacts.emplace_back(new Contact(
                         result->b->get_world_space_vertex(this_vb),
-                        glm::normalize(result->a->get_non_unit_normal(fai)),
+                        result->a->get_unit_normal(fai),
                         result->b, result->a,
-                        result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][0].first)));
+                        result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][0].first),
+                        Feature::vertex(this_vb), Feature::face(fai)));
             } else if (prev_vb_inside && !this_vb_inside) {
                 // only add intersection
             } else { // if (prev_vb_inside && this_vb_inside)
                 // only add current endpoint
                 contacts.emplace_back(new Contact(
                         result->b->get_world_space_vertex(this_vb),
-                        glm::normalize(result->a->get_non_unit_normal(fai)),
+                        result->a->get_unit_normal(fai),
                         result->b, result->a,
-                        result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][0].first)));
+                        result->a->get_world_space_vertex(result->a->shape->get_faces()[fai][0].first),
+                        Feature::vertex(this_vb), Feature::face(fai)));
             }
 
             prev_vb_inside = this_vb_inside;
@@ -0,0 +1,81 @@
+#include "contact_manifold_cache.hpp"
+#include "collision_detection.hpp"
+
+uint64_t ContactManifoldCache::get_key(uint32_t i, uint32_t j)
+{
+    // the order of the bodies in a contact may differ between contacts of a pair
+    if (i > j) std::swap(i, j);
+    return (uint64_t) i << 32u | j;
+}
+
+void ContactManifoldCache::match(const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies)
+{
+    for (auto &contact : contacts) {
+        contact->force = 0.;
+        if (!enabled) continue;
+
+        auto a = (uint32_t) (contact->body_a - bodies.data());
+        auto b = (uint32_t) (contact->body_b - bodies.data());
+        auto it = manifolds.find(get_key(a, b));
+        bool found = false;
+        if (it != manifolds.end()) {
+            for (auto &point : it->second.points) {
+                if (point.body_a == a && point.feature_a == contact->feature_a &&
+                    point.feature_b == contact->feature_b) {
+                    contact->force = point.force;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        if (found) hits++; else misses++;
+    }
+}
+
+void ContactManifoldCache::update(const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies)
+{
+    // keep the capacity of the manifolds of pairs that remain in contact. pairs of which neither body is moving are
+    // not tested in this substep, such that their contacts are not in {contacts} and their manifolds are kept
+    for (auto &manifold : manifolds) {
+        auto a = (uint32_t) (manifold.first >> 32u);
+        auto b = (uint32_t) manifold.first;
+        if (!CollisionDetection::is_moving(&bodies[a]) && !CollisionDetection::is_moving(&bodies[b])) continue;
+        manifold.second.points.clear();
+    }
+
+    for (auto &contact : contacts) {
+        auto a = (uint32_t) (contact->body_a - bodies.data());
+        auto b = (uint32_t) (contact->body_b - bodies.data());
+        manifolds[get_key(a, b)].points.push_back({a, contact->feature_a, contact->feature_b, contact->force});
+    }
+
+    for (auto it = manifolds.begin(); it != manifolds.end();) {
+        if (it->second.points.empty()) {
+            it = manifolds.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void ContactManifoldCache::clear()
+{
+    manifolds.clear();
+}
+
+uint64_t ContactManifoldCache::get_hits() const
+{
+    return hits;
+}
+
+uint64_t ContactManifoldCache::get_misses() const
+{
+    return misses;
+}
+
+void ContactManifoldCache::reset_counts()
+{
+    hits = 0;
+    misses = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef SIMULATION_CONTACT_MANIFOLD_CACHE_HPP
+#define SIMULATION_CONTACT_MANIFOLD_CACHE_HPP
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include "contact.hpp"
+
+/** Contact of a {ContactManifold}, identified by the features that form it. */
+struct ManifoldPoint {
+    /** Index in {BodySystem::bodies} of {Contact::body_a}. */
+    uint32_t body_a;
+    uint32_t feature_a;
+    uint32_t feature_b;
+    /** Contact force solved for the contact. */
+    double force;
+};
+
+/** Contacts between a pair of bodies. */
+struct ContactManifold {
+    std::vector<ManifoldPoint> points;
+};
+
+/**
+ * Remembers per pair of bodies the contacts of the last step and the forces solved for them. Between steps, a
+ * resting contact is formed by the same features and its force barely changes, so the remembered force is a good
+ * initial guess for {math::qp_solve}. */
+class ContactManifoldCache {
+private:
+    /** Manifold of every pair in contact when it was last tested, as of the calls to {update}, by {get_key}. */
+    std::unordered_map<uint64_t, ContactManifold> manifolds;
+
+    /** Number of contacts for which {match} found a contact of the last step. */
+    uint64_t hits = 0;
+
+    /** Number of contacts for which {match} found none. */
+    uint64_t misses = 0;
+
+    static uint64_t get_key(uint32_t i, uint32_t j);
+public:
+    /** If false, {match} sets every force to zero, such that no initial guess is used. */
+    bool enabled = true;
+
+    /**
+     * Sets {Contact::force} of every contact to the force of the contact of the last step which is formed by the
+     * same features between the same bodies, or to zero if there is none. {bodies} is {BodySystem::bodies}. */
+    void match(const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies);
+
+    /**
+     * Replaces the manifolds of all pairs with a moving body by {contacts} and their solved {Contact::force}. The
+     * manifolds of pairs of which neither body is moving, see {CollisionDetection::is_moving}, are kept, as such
+     * pairs are not tested, for instance those of finished bodies in a localized substep. */
+    void update(const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies);
+
+    /** Forget all pairs, for instance when the bodies are replaced. */
+    void clear();
+
+    uint64_t get_hits() const;
+
+    uint64_t get_misses() const;
+
+    /** Reset the hit and miss counts. */
+    void reset_counts();
+};
+
+#endif //SIMULATION_CONTACT_MANIFOLD_CACHE_HPP
@@ -0,0 +1,12 @@
+#ifndef SIMULATION_CONTACT_SOLVER_TYPE_HPP
+#define SIMULATION_CONTACT_SOLVER_TYPE_HPP
+
+/** Algorithm with which {CollisionHandling} solves the forces of resting contacts. */
+enum ContactSolverType {
+    /** Exact pivoting, see {math::qp_solve}. */
+    DANTZIG,
+    /** Iterative with a bounded number of sweeps, see {math::pgs_solve}. */
+    PROJECTED_GAUSS_SEIDEL
+};
+
+#endif //SIMULATION_CONTACT_SOLVER_TYPE_HPP
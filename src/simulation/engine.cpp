@@ -1,13 +1,31 @@
 #include "engine.hpp"
+#include "contact_manifold_cache.hpp"
+#include "thread_pool.hpp"
+#include "sleeping.hpp"
+#include "time_of_impact.hpp"
+#include "island.hpp"
+#include "outcome.hpp"
+#include "broadphase/aabb.hpp"
 
 Engine::~Engine()
 {
     cleanup();
+    delete scene;
 }
 
 void Engine::init()
 {
     body_system = scene->initialize();
+    body_system->set_broadphase(Broadphase::create(broadphase_type, DISTANCE_THRESHOLD));
+    body_system->narrowphase_type = narrowphase_type;
+    body_system->contact_solver_type = contact_solver_type;
+    body_system->pgs_max_iterations = pgs_max_iterations;
+    body_system->pgs_tolerance = pgs_tolerance;
+    body_system->manifold_cache->enabled = warm_start;
+    body_system->use_islands = islands;
+    body_system->use_sleeping = sleeping;
+    body_system->set_thread_pool(new ThreadPool(threads));
+    calm_time = 0.;
 }
 
 void Engine::update()
@@ -15,11 +33,30 @@ void Engine::update()
     if (!run && !step_once) return;
 
     // perform an integration step
+    uint64_t truncated = truncated_steps;
     step();
+    Sleeping::update(body_system, prev_contacts, dt);
+
+    // the bodies of a truncated step stopped short of its end, so it does not count towards {settle_time}
+    if (truncated_steps == truncated) {
+        bool calm = Outcome::specific_kinetic_energy(body_system) < settle_energy;
+        calm_time = calm ? calm_time + dt : 0.;
+    }
 
     step_once = false;
 }
 
+bool Engine::is_settled() const
+{
+    if (calm_time >= settle_time) return true;
+
+    for (auto &body : body_system->bodies) {
+        if (Sleeping::is_active(&body)) return false;
+    }
+
+    return true;
+}
+
 void Engine::toggle_run()
 {
     run = !run;
@@ -48,22 +85,56 @@ void Engine::ask_to_step_once()
     step_once = true;
 }
 
-bool equal(RigidBody *x, RigidBody *y)
+/**
+ * Marks the integrated bodies which are not connected to a body of {pairs} as finished. Bodies are connected
+ * through {contacts} and through overlapping bounding boxes over the last integration, such that moving the
+ * connected bodies back in time does not make them interpenetrate a finished body. */
+void finish_unaffected(
+        BodySystem *body_system, const std::vector<std::pair<uint32_t, uint32_t>> &pairs,
+        const std::vector<Contact *> &contacts)
 {
-    if (x->x != y->x) return false;
-    if (x->p != y->p) return false;
+    std::vector<RigidBody> &bodies = body_system->bodies;
+    UnionFind groups(bodies.size());
+    for (auto &contact : contacts) {
+        if (!CollisionDetection::is_moving(contact->body_a) ||
+            !CollisionDetection::is_moving(contact->body_b)) continue;
+        groups.unite(contact->body_a - bodies.data(), contact->body_b - bodies.data());
+    }
 
-    if (x->a != y->a) return false;
-    if (x->l != y->l) return false;
+    // bounding boxes of the moving bodies at the start and the end of the integration, sorted along x. Immovable
+    // bodies are left out, as they would connect every body resting on them
+    const BodyState &state = body_system->body_state;
+    std::vector<Aabb> boxes(bodies.size());
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < state.size(); i++) {
+        uint32_t j = state.index[i];
+        if (!CollisionDetection::is_moving(&bodies[j])) continue;
 
-    if (x->v != y->v) return false;
-    if (x->i_inv != y->i_inv) return false;
-    if (x->omega != y->omega) return false;
+        RigidBody start = bodies[j];
+        start.x = state.x_0[i];
+        start.q = state.q_0[i];
+        boxes[j] = Aabb(&bodies[j], Engine::DISTANCE_THRESHOLD).merge(Aabb(&start, Engine::DISTANCE_THRESHOLD));
+        order.emplace_back(j);
+    }
+    std::sort(order.begin(), order.end(), [&boxes](uint32_t a, uint32_t b) {
+        return boxes[a].min.x < boxes[b].min.x;
+    });
+    for (uint32_t a = 0; a < order.size(); a++) {
+        for (uint32_t b = a + 1; b < order.size() && boxes[order[b]].min.x <= boxes[order[a]].max.x; b++) {
+            if (boxes[order[a]].overlaps(boxes[order[b]])) groups.unite(order[a], order[b]);
+        }
+    }
 
-    if (x->force != y->force) return false;
-    if (x->torque != y->torque) return false;
+    std::vector<bool> affected(bodies.size(), false);
+    for (auto &pair : pairs) {
+        affected[groups.find(pair.first)] = true;
+        affected[groups.find(pair.second)] = true;
+    }
 
-    return true;
+    for (uint32_t i = 0; i < state.size(); i++) {
+        uint32_t j = state.index[i];
+        if (!affected[groups.find(j)]) bodies[j].finished = true;
+    }
 }
 
 void Engine::step()
@@ -73,81 +144,131 @@ void Engine::step()
     }
     prev_contacts.clear();
 
+    // impulses applied to sleeping bodies between the steps
+    Sleeping::wake_pushed(body_system);
+
     double t_current = 0.;
+    uint32_t substeps = 0;
     while (t_current < dt) {
         double t_target = dt - t_current;
 //        CollisionHandling::correct_state(body_system); // todo debug
         std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(body_system);
 
+        // bodies touched by an active body wake, after which the contacts between the woken bodies are needed
+        while (Sleeping::wake_touched(body_system, contacts)) {
+            for (auto &contact : contacts) {
+                delete contact;
+            }
+            contacts = CollisionDetection::find_all_contacts(body_system);
+        }
+
         bool had_collision;
         do {
             had_collision = CollisionHandling::find_all_collisions(contacts);
         } while (had_collision);
 
-        Integrator::clear_forces(body_system);
         Integrator::apply_forces(body_system);
-        CollisionHandling::compute_contact_forces(contacts);
+        pivots += CollisionHandling::compute_contact_forces(body_system, contacts);
+        body_system->manifold_cache->update(contacts, body_system->bodies);
 
-        std::vector<RigidBody> bodies_t0 = body_system->bodies;
+        // the state at t0 is kept by the integrator, to be restored by {Integrator::repeat_runge_kutta_4}
         Integrator::runge_kutta_4(body_system, t_target);
-        if (!CollisionDetection::intersect(body_system)) {
+        integrated_bodies += body_system->body_state.size();
+        bool penetrating;
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        if (conservative_advancement || localized_substeps) {
+            pairs = CollisionDetection::find_penetrating_pairs(body_system);
+            penetrating = !pairs.empty();
+        } else {
+            penetrating = CollisionDetection::intersect(body_system);
+        }
+
+        if (!penetrating) {
             // free the contact list
             for (auto &contact : contacts) {
                 prev_contacts.emplace_back(contact);
             }
-            return;
+            break;
         }
 
-        double t = t_target * .5;
-        double t_step = t_target * .5;
-        bool searching = true;
-        while (searching) {
-            // restore state
-            body_system->bodies = bodies_t0;
-
-            // apply step
-            Integrator::runge_kutta_4(body_system, t);
-
-            // calculate whether the current time is correct
-            CollisionState state = CollisionDetection::find_collision_state(body_system);
-            switch (state) {
-                case PENETRATING:
-                    // we are too deep, step back (we are interpenetrating)
-                    t_step *= .5;
-                    t = t - t_step;
-                    break;
-                case CONTACT_RESTING_OR_COLLIDING:
-                    // t_c = t
-                    searching = false;
-                    break;
-                case CONTACT_SEPARATING:
-                case NOT_PENETRATING:
-                    // we are too far out, step forward (we are not even in contact anymore)
-                    t_step *= .5;
-                    t = t + t_step;
-                    break;
-            }
-            if (t_step == 0.) {
-                printf("cannot find time of collision\n"); // todo debug
+        // the bodies apart from the interpenetrating pairs have reached the end of the step
+        if (localized_substeps) {
+            finish_unaffected(body_system, pairs, contacts);
+            body_system->body_state.remove_finished(body_system->bodies);
+        }
+
+        // advance once to the earliest time of impact of the penetrating pairs, if that does not result in
+        // contact, search the time of collision by bisection
+        impacts++;
+        double t = 0.;
+        if (conservative_advancement) {
+            t = TimeOfImpact::find(body_system, pairs, t_target);
+            if (t > 0.) {
+                Integrator::repeat_runge_kutta_4(body_system, t);
+                repeated_integrations++;
+                integrated_bodies += body_system->body_state.size();
+                if (CollisionDetection::find_collision_state(body_system) != CONTACT_RESTING_OR_COLLIDING) t = 0.;
             }
         }
+        if (t == 0.) {
+            t = bisect(t_target);
+        }
 
         t_current += t;
 
+        // a substep which leaves the bodies as they were would be repeated identically until the end of the step
+        bool stalled = !Integrator::has_progressed(body_system) || ++substeps == max_substeps;
+
         // free the contact list
         for (auto &contact : contacts) {
             prev_contacts.emplace_back(contact);
         }
 
-        bool change = false;
-        for (uint32_t i = 0; i < bodies_t0.size(); i++) {
-            if (!equal(&bodies_t0[i], &body_system->bodies[i])) {
-                change = true;
-            }
+        if (stalled) {
+            truncated_steps++;
+            break;
         }
+    }
 
-        if (!change) {
-            printf("nonprogress\n"); // todo debug
+    for (auto &body : body_system->bodies) {
+        body.finished = false;
+    }
+}
+
+double Engine::bisect(double t_target)
+{
+    double t = t_target * .5;
+    double t_step = t_target * .5;
+    bool searching = true;
+    while (searching) {
+        // restore state and apply step
+        Integrator::repeat_runge_kutta_4(body_system, t);
+        repeated_integrations++;
+        integrated_bodies += body_system->body_state.size();
+
+        // calculate whether the current time is correct
+        CollisionState state = CollisionDetection::find_collision_state(body_system);
+        switch (state) {
+            case PENETRATING:
+                // we are too deep, step back (we are interpenetrating)
+                t_step *= .5;
+                t = t - t_step;
+                break;
+            case CONTACT_RESTING_OR_COLLIDING:
+                // t_c = t
+                searching = false;
+                break;
+            case CONTACT_SEPARATING:
+            case NOT_PENETRATING:
+                // we are too far out, step forward (we are not even in contact anymore)
+                t_step *= .5;
+                t = t + t_step;
+                break;
+        }
+        if (t_step == 0.) {
+            printf("cannot find time of collision\n"); // todo debug
         }
     }
-}
\ No newline at end of file
+
+    return t;
+}
@@ -42,6 +42,73 @@ public:
 
     Scene *scene = new RandomScene();
 
+    /** Broadphase used by the body system, applied at {init}. */
+    BroadphaseType broadphase_type = SWEEP_AND_PRUNE;
+
+    /** Narrowphase used by the body system, applied at {init}. */
+    NarrowphaseType narrowphase_type = SAT;
+
+    /** Solver of the forces of resting contacts, applied at {init}. */
+    ContactSolverType contact_solver_type = DANTZIG;
+
+    /** Sweep budget and residual tolerance of {PROJECTED_GAUSS_SEIDEL}, applied at {init}. */
+    uint32_t pgs_max_iterations = 50;
+    double pgs_tolerance = 1.e-6;
+
+    /** Whether the contact forces of the previous step are used as initial guess, applied at {init}. */
+    bool warm_start = true;
+
+    /** Whether the contact forces of every island are solved separately, applied at {init}. */
+    bool islands = true;
+
+    /** Number of threads solving islands concurrently, zero for the number of hardware threads, applied at
+     *  {init}. */
+    uint32_t threads = 0;
+
+    /** Whether bodies at rest are put to sleep, applied at {init}. */
+    bool sleeping = true;
+
+    /**
+     * Whether the time of collision is found by conservative advancement of the interpenetrating pairs, see
+     * {TimeOfImpact}, before falling back to bisection. */
+    bool conservative_advancement = true;
+
+    /**
+     * Whether only the bodies connected to an interpenetrating pair, through contacts or overlapping bounding
+     * boxes, search the time of collision and take substeps. The others keep the integration over the remainder of
+     * the step, see {RigidBody::finished}. */
+    bool localized_substeps = true;
+
+    /**
+     * Number of times a step may stop at a time of collision, after which the rest of the step is dropped, see
+     * {truncated_steps}. */
+    uint32_t max_substeps = 100;
+
+    /**
+     * The bodies have settled once the kinetic energy per unit of mass of each of them, see
+     * {Outcome::specific_kinetic_energy}, stays below {settle_energy} for {settle_time}, or once no body is active.
+     * This ends a roll before all dice have fallen asleep, see {is_settled}. The energy is far below what tipping a
+     * die of unit size over an edge takes, the time is longer than a die spends near the top of a bounce. */
+    double settle_energy = .01;
+    double settle_time = .25;
+
+    /** Number of times the time of collision was searched, summed over all steps. */
+    uint64_t impacts = 0;
+
+    /** Number of times the bodies were integrated again searching the time of collision, summed over all steps. */
+    uint64_t repeated_integrations = 0;
+
+    /** Number of bodies integrated, summed over all integrations of all steps. */
+    uint64_t integrated_bodies = 0;
+
+    /** Number of pivots performed solving for contact forces, summed over all steps. */
+    uint64_t pivots = 0;
+
+    /**
+     * Number of steps of which the rest was dropped, because a substep did not progress or after {max_substeps}.
+     * Such a step does not count towards {settle_time}. */
+    uint64_t truncated_steps = 0;
+
     BodySystem *body_system = nullptr;
 
     /** For debugging purposes, maintain a list of intermediate contacts for every step. */
@@ -59,6 +126,9 @@ public:
 
     void change_scene(Scene *p_scene);
 
+    /** Whether the bodies have stopped moving, see {settle_energy}. */
+    bool is_settled() const;
+
     /** Reset the simulation. */
     void reset();
 
@@ -70,8 +140,16 @@ public:
     void ask_to_step_once();
 
 private:
+    /** Time the kinetic energy has been below {settle_energy}. */
+    double calm_time = 0.;
+
     /** Progress the body system with a single time step. */
     void step();
+
+    /**
+     * Searches the time in [0, {t_target}] at which the bodies are in contact but do not interpenetrate, by
+     * bisection, re-integrating from the start of the step at every iteration. Leaves the bodies at that time. */
+    double bisect(double t_target);
 };
 
 #endif //SIMULATION_ENGINE_HPP
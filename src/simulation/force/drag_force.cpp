@@ -5,8 +5,9 @@ DragForce::DragForce(BodySystem *p_body_system) : Force(p_body_system)
 
 void DragForce::apply_force_and_torque()
 {
-    for (auto &body : body_system->bodies) {
-        body.force -= linear_drag_constant * body.p;
-        body.torque -= angular_drag_constant * body.l;
+    BodyState &state = body_system->body_state;
+    for (uint32_t i = 0; i < state.size(); i++) {
+        state.force[i] -= linear_drag_constant * state.p[i];
+        state.torque[i] -= angular_drag_constant * state.l[i];
     }
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ protected:
 public:
     Force(BodySystem *p_body_system);
 
-    /** Apply the force to all rigid bodies in {body_system}. */
+    /** Apply the force to all rigid bodies in {body_system}, through {BodySystem::body_state}. */
     virtual void apply_force_and_torque() = 0;
 
     virtual ~Force();
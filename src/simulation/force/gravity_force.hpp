@@ -10,8 +10,6 @@ private:
 public:
     explicit GravityForce(BodySystem *p_body_system);
 
-    glm::dvec3 calculate_gravity(RigidBody *rigid_body);
-
     void apply_force_and_torque() override;
 };
 
@@ -0,0 +1,332 @@
+#include "gjk.hpp"
+
+/** Upper bound on the number of iterations, GJK converges in far fewer for the shapes used. */
+const uint32_t MAX_ITERATIONS = 64;
+
+/** Relative tolerance on the squared distance to decide GJK has converged. */
+const double RELATIVE_TOLERANCE = 1e-12;
+
+/** Squared distance below which the origin is considered to be contained. */
+const double ABSOLUTE_TOLERANCE = 1e-24;
+
+/**
+ * Translation of {y}, equal to the translation {Collision::intersect} applies to bodies translated towards each
+ * other. Bodies translated apart are not translated, see {Gjk::overlap}. */
+glm::dvec3 get_translation(RigidBody *x, RigidBody *y, double offset)
+{
+    return offset > 0. ? offset * glm::normalize(x->x - y->x) : glm::dvec3(0.);
+}
+
+/** Support point of the configuration space in direction {d}. */
+Gjk::SimplexVertex get_support(RigidBody *x, RigidBody *y, glm::dvec3 translation, glm::dvec3 d)
+{
+    // furthest vertex of y along d, and furthest vertex of x along -d
+    const std::vector<glm::dvec3> &vertices_x = x->get_world_space_vertices();
+    uint32_t ix = 0;
+    for (uint32_t i = 1; i < vertices_x.size(); i++) {
+        if (glm::dot(d, vertices_x[i]) < glm::dot(d, vertices_x[ix])) ix = i;
+    }
+
+    const std::vector<glm::dvec3> &vertices_y = y->get_world_space_vertices();
+    uint32_t iy = 0;
+    for (uint32_t i = 1; i < vertices_y.size(); i++) {
+        if (glm::dot(d, vertices_y[i]) > glm::dot(d, vertices_y[iy])) iy = i;
+    }
+
+    return {vertices_y[iy] + translation - vertices_x[ix], ix, iy};
+}
+
+/** Closest point to the origin on the segment in {simplex}, which is reduced to the vertices supporting it. */
+glm::dvec3 closest_on_segment(std::vector<Gjk::SimplexVertex> *simplex)
+{
+    Gjk::SimplexVertex a = (*simplex)[0];
+    Gjk::SimplexVertex b = (*simplex)[1];
+    glm::dvec3 ab = b.w - a.w;
+
+    double t = glm::dot(-a.w, ab);
+    if (t <= 0.) {
+        *simplex = {a};
+        return a.w;
+    }
+
+    double denominator = glm::dot(ab, ab);
+    if (t >= denominator) {
+        *simplex = {b};
+        return b.w;
+    }
+
+    return a.w + (t / denominator) * ab;
+}
+
+/**
+ * Closest point to the origin on the triangle in {simplex}, which is reduced to the vertices supporting it.
+ * Based on the Voronoi region tests in Ericson, Real-Time Collision Detection, section 5.1.5. */
+glm::dvec3 closest_on_triangle(std::vector<Gjk::SimplexVertex> *simplex)
+{
+    Gjk::SimplexVertex a = (*simplex)[0];
+    Gjk::SimplexVertex b = (*simplex)[1];
+    Gjk::SimplexVertex c = (*simplex)[2];
+    glm::dvec3 ab = b.w - a.w;
+    glm::dvec3 ac = c.w - a.w;
+
+    double d1 = glm::dot(ab, -a.w);
+    double d2 = glm::dot(ac, -a.w);
+    if (d1 <= 0. && d2 <= 0.) {
+        *simplex = {a};
+        return a.w;
+    }
+
+    double d3 = glm::dot(ab, -b.w);
+    double d4 = glm::dot(ac, -b.w);
+    if (d3 >= 0. && d4 <= d3) {
+        *simplex = {b};
+        return b.w;
+    }
+
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0. && d1 >= 0. && d3 <= 0.) {
+        *simplex = {a, b};
+        return a.w + (d1 / (d1 - d3)) * ab;
+    }
+
+    double d5 = glm::dot(ab, -c.w);
+    double d6 = glm::dot(ac, -c.w);
+    if (d6 >= 0. && d5 <= d6) {
+        *simplex = {c};
+        return c.w;
+    }
+
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0. && d2 >= 0. && d6 <= 0.) {
+        *simplex = {a, c};
+        return a.w + (d2 / (d2 - d6)) * ac;
+    }
+
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0. && d4 - d3 >= 0. && d5 - d6 >= 0.) {
+        *simplex = {b, c};
+        return b.w + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c.w - b.w);
+    }
+
+    // the origin projects inside the triangle
+    double denominator = 1. / (va + vb + vc);
+    return a.w + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * Closest point to the origin on the tetrahedron in {simplex}, which is reduced to the vertices supporting it.
+ * Returns false if the origin is contained in the tetrahedron, in which case {simplex} is unchanged. */
+bool closest_on_tetrahedron(std::vector<Gjk::SimplexVertex> *simplex, glm::dvec3 *v)
+{
+    const uint32_t FACES[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+    std::vector<Gjk::SimplexVertex> tetrahedron = *simplex;
+    bool outside = false;
+    double best = DBL_MAX;
+    for (auto &face : FACES) {
+        glm::dvec3 a = tetrahedron[face[0]].w;
+        glm::dvec3 n = glm::cross(tetrahedron[face[1]].w - a, tetrahedron[face[2]].w - a);
+        double side_origin = glm::dot(-a, n);
+        double side_opposite = glm::dot(tetrahedron[face[3]].w - a, n);
+        // the origin lies on the other side of this face than the opposite vertex, if the tetrahedron is
+        // degenerate this cannot be decided and the face is tested as well
+        if (side_origin * side_opposite > 0. && side_opposite != 0.) continue;
+
+        outside = true;
+        std::vector<Gjk::SimplexVertex> triangle = {
+                tetrahedron[face[0]], tetrahedron[face[1]], tetrahedron[face[2]]};
+        glm::dvec3 q = closest_on_triangle(&triangle);
+        if (glm::dot(q, q) < best) {
+            best = glm::dot(q, q);
+            *v = q;
+            *simplex = triangle;
+        }
+    }
+
+    return outside;
+}
+
+/** Reduces {simplex} to the smallest subset containing its closest point to the origin, which is returned. */
+bool reduce(std::vector<Gjk::SimplexVertex> *simplex, glm::dvec3 *v)
+{
+    switch (simplex->size()) {
+        case 1:
+            *v = (*simplex)[0].w;
+            return true;
+        case 2:
+            *v = closest_on_segment(simplex);
+            return true;
+        case 3:
+            *v = closest_on_triangle(simplex);
+            return true;
+        case 4:
+            return closest_on_tetrahedron(simplex, v);
+        default:
+            assert(0); // a simplex in 3d has at most four vertices
+            return false;
+    }
+}
+
+/** Returns true if {vertex} is already part of {simplex}, adding it again would not make progress. */
+bool contains(const std::vector<Gjk::SimplexVertex> &simplex, const Gjk::SimplexVertex &vertex)
+{
+    for (auto &s : simplex) {
+        if (s.ix == vertex.ix && s.iy == vertex.iy) return true;
+    }
+
+    return false;
+}
+
+Gjk::DistanceResult Gjk::distance(RigidBody *x, RigidBody *y, double offset)
+{
+    glm::dvec3 translation = get_translation(x, y, offset);
+
+    DistanceResult result;
+    result.intersect = false;
+    result.converged = true;
+    result.simplex = {get_support(x, y, translation, x->x - y->x)};
+    result.v = result.simplex[0].w;
+
+    for (uint32_t i = 0; i < MAX_ITERATIONS; i++) {
+        double vv = glm::dot(result.v, result.v);
+        if (vv <= ABSOLUTE_TOLERANCE) {
+            // the bodies touch
+            result.intersect = true;
+            return result;
+        }
+
+        SimplexVertex w = get_support(x, y, translation, -result.v);
+        if (vv - glm::dot(result.v, w.w) <= RELATIVE_TOLERANCE * vv || contains(result.simplex, w)) {
+            // no progress towards the origin can be made, v is the closest point
+            return result;
+        }
+
+        std::vector<SimplexVertex> simplex = result.simplex;
+        simplex.emplace_back(w);
+        glm::dvec3 v;
+        if (!reduce(&simplex, &v)) {
+            // the origin is contained
+            result.intersect = true;
+            return result;
+        }
+
+        if (glm::dot(v, v) >= vv) {
+            // due to rounding, the distance no longer decreases
+            return result;
+        }
+        result.simplex = simplex;
+        result.v = v;
+    }
+
+    result.converged = false;
+    return result;
+}
+
+bool Gjk::overlap(RigidBody *x, RigidBody *y, double offset)
+{
+    // translated apart, the bodies are translated along the normal of every plane, which no single translation of
+    // the configuration space does. bodies which do not intersect do not intersect translated apart either, the
+    // separating plane scan decides for the others
+    if (offset < 0.) return overlap(x, y, 0.) && Collision::intersect(x, y, offset).intersect;
+
+    glm::dvec3 translation = get_translation(x, y, offset);
+
+    std::vector<SimplexVertex> simplex = {get_support(x, y, translation, x->x - y->x)};
+    glm::dvec3 v = simplex[0].w;
+
+    for (uint32_t i = 0; i < MAX_ITERATIONS; i++) {
+        double vv = glm::dot(v, v);
+        if (vv <= ABSOLUTE_TOLERANCE) return true;
+
+        SimplexVertex w = get_support(x, y, translation, -v);
+        // the plane through w with normal v separates the origin from the configuration space
+        if (glm::dot(v, w.w) > 0.) return false;
+        // no progress can be made, this only happens in degenerate cases
+        if (contains(simplex, w)) break;
+
+        simplex.emplace_back(w);
+        if (!reduce(&simplex, &v)) return true;
+        // due to rounding, the distance no longer decreases
+        if (glm::dot(v, v) >= vv) break;
+    }
+
+    // fall back to the exhaustive test
+    return Collision::intersect(x, y, offset).intersect;
+}
+
+/** Returns true if every index in {indices} is a vertex of {face}. */
+bool face_contains(const std::vector<std::pair<uint32_t, glm::vec2>> &face, const std::vector<uint32_t> &indices)
+{
+    for (auto &index : indices) {
+        bool found = false;
+        for (auto &vertex : face) {
+            if (vertex.first == index) found = true;
+        }
+        if (!found) return false;
+    }
+
+    return true;
+}
+
+/** Returns true if every index in {indices} is an endpoint of {edge}. */
+bool edge_contains(const std::pair<uint32_t, uint32_t> &edge, const std::vector<uint32_t> &indices)
+{
+    for (auto &index : indices) {
+        if (edge.first != index && edge.second != index) return false;
+    }
+
+    return true;
+}
+
+Collision::IntersectResult Gjk::intersect(RigidBody *x, RigidBody *y, double offset)
+{
+    DistanceResult distance_result = distance(x, y, offset);
+    if (distance_result.intersect || !distance_result.converged) {
+        // when the bodies (nearly) touch, the tolerances of GJK may disagree with the exact test, the separating
+        // plane scan is authoritative. Without the closest features, there is nothing to test first
+        return Collision::intersect(x, y, offset);
+    }
+
+    // the closest features of x and y
+    std::vector<uint32_t> closest_x, closest_y;
+    for (auto &s : distance_result.simplex) {
+        if (std::find(closest_x.begin(), closest_x.end(), s.ix) == closest_x.end()) closest_x.emplace_back(s.ix);
+        if (std::find(closest_y.begin(), closest_y.end(), s.iy) == closest_y.end()) closest_y.emplace_back(s.iy);
+    }
+
+    // test the planes formed by the closest features, preferring faces of x, then faces of y, then pairs of edges
+    Collision::IntersectResult result;
+    Collision::SeparatingFeature feature;
+    feature.ee = false;
+    feature.on_x = true;
+    for (uint32_t i = 0; i < x->shape->get_faces().size(); i++) {
+        if (!face_contains(x->shape->get_faces()[i], closest_x)) continue;
+        feature.i = i;
+        if (Collision::test_feature(x, y, feature, offset, &result)) return result;
+    }
+
+    feature.on_x = false;
+    for (uint32_t i = 0; i < y->shape->get_faces().size(); i++) {
+        if (!face_contains(y->shape->get_faces()[i], closest_y)) continue;
+        feature.i = i;
+        if (Collision::test_feature(x, y, feature, offset, &result)) return result;
+    }
+
+    feature.ee = true;
+    for (uint32_t i = 0; i < x->shape->get_edges().size(); i++) {
+        if (!edge_contains(x->shape->get_edges()[i], closest_x)) continue;
+        for (uint32_t j = 0; j < y->shape->get_edges().size(); j++) {
+            if (!edge_contains(y->shape->get_edges()[j], closest_y)) continue;
+            feature.i = i;
+            feature.j = j;
+            feature.on_x = true;
+            if (Collision::test_feature(x, y, feature, offset, &result)) return result;
+            feature.on_x = false;
+            if (Collision::test_feature(x, y, feature, offset, &result)) return result;
+        }
+    }
+
+    // the closest features do not form a separating plane, this happens when GJK terminates on a simplex that
+    // does not contain the closest features, or when a closer feature does not form a separating plane
+    return Collision::intersect(x, y, offset);
+}
@@ -0,0 +1,58 @@
+#ifndef SIMULATION_GJK_HPP
+#define SIMULATION_GJK_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <algorithm>
+
+#include "rigid_body.hpp"
+#include "collision.hpp"
+
+/**
+ * Gilbert-Johnson-Keerthi distance queries on the convex hulls of two bodies, as an alternative to the separating
+ * plane scan of {Collision::intersect}. For a positive {offset}, the bodies are offset exactly as in
+ * {Collision::intersect}: {y} is translated by {offset} towards {x}. A negative {offset} translates the bodies apart
+ * along the normal of every plane, which {overlap} leaves to the scan for bodies which intersect. GJK works in the
+ * configuration space of {x} and {y}, where the points are y - x, such that the bodies intersect if the origin is
+ * contained in it. */
+namespace Gjk {
+    /** Point in configuration space, with the vertices of {x} and {y} it is formed by. */
+    struct SimplexVertex {
+        glm::dvec3 w;
+        /** Index of the vertex of x. */
+        uint32_t ix;
+        /** Index of the vertex of y. */
+        uint32_t iy;
+    };
+
+    /** Result of {distance}. */
+    struct DistanceResult {
+        /** Whether they intersect, if so the other fields are undefined. */
+        bool intersect;
+        /**
+         * Whether {v} is the closest point. If the iterations ran out first, {v} is a point of the configuration
+         * space which only bounds the distance from above. */
+        bool converged;
+        /** Closest point in configuration space to the origin, pointing from x to y. */
+        glm::dvec3 v;
+        /** Vertices of the smallest simplex containing {v}, these identify the closest features. */
+        std::vector<SimplexVertex> simplex;
+    };
+
+    /** Computes the distance between the (offset) bodies, which are not translated for a negative {offset}. */
+    DistanceResult distance(RigidBody *x, RigidBody *y, double offset);
+
+    /**
+     * Returns true if the (offset) bodies intersect. Stops as soon as a separating axis is found,
+     * without computing the distance. */
+    bool overlap(RigidBody *x, RigidBody *y, double offset);
+
+    /**
+     * Equivalent to {Collision::intersect}. The closest features found by {distance} are tested as separating
+     * planes in the order {Collision::intersect} prefers them, if none of them separates the bodies the full scan
+     * is performed. */
+    Collision::IntersectResult intersect(RigidBody *x, RigidBody *y, double offset);
+}
+
+#endif //SIMULATION_GJK_HPP
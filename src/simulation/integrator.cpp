@@ -9,6 +9,8 @@ void Integrator::clear_forces(BodySystem *body_system)
 
 void Integrator::apply_forces(BodySystem *body_system)
 {
+    // the forces operate on {BodySystem::body_state}, which is read once here and written by {runge_kutta_4}
+    body_system->body_state.load(body_system->bodies);
     for (auto &force : body_system->forces) {
         force->apply_force_and_torque();
     }
@@ -25,155 +27,141 @@ glm::dmat3 Integrator::star(glm::dvec3 a)
     return r_val;
 }
 
-void Integrator::runge_kutta_4(BodySystem *body_system, double dt)
+glm::dquat Integrator::spin(glm::dvec3 omega, glm::dquat q)
 {
-    std::vector<RigidBody> initial_state = body_system->bodies; // save the state at t0
-
-    /** k1 */
-
-    // calculate hf(x0, t0)
-    for (auto &body : body_system->bodies) {
-        // compute the change in variables
-        body.x = dt * body.v;
-        body.p = dt * body.force;
-        body.a = dt * star(body.omega) * body.a;
-        body.l = dt * body.torque;
-
-//        body.a = glm::orthonormalize(body.a);
+    return .5 * (glm::dquat(0., omega) * q);
+}
 
-        // compute change in auxiliary variables
-        body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
-        body.omega = body.i_inv * body.l;
+/** Computes the change of the quantities over {dt} for the current state of {s}, equal to h * f(x, t). */
+void compute_delta(BodyState *s, double dt)
+{
+    for (uint32_t i = 0; i < s->size(); i++) {
+        s->x_delta[i] = dt * s->v[i];
+        s->p_delta[i] = dt * s->force[i];
+        s->q_delta[i] = dt * Integrator::spin(s->omega[i], s->q[i]);
+        s->l_delta[i] = dt * s->torque[i];
     }
+}
 
-    std::vector<RigidBody> k1 = body_system->bodies;
-
-    /** k2 */
-
-    // set state to x0 + k1/2
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        body_system->bodies[i].x = initial_state[i].x + .5 * k1[i].x;
-        body_system->bodies[i].p = initial_state[i].p + .5 * k1[i].p;
-        body_system->bodies[i].a = initial_state[i].a + .5 * k1[i].a;
-        body_system->bodies[i].l = initial_state[i].l + .5 * k1[i].l;
-
-        body_system->bodies[i].a = glm::orthonormalize(body_system->bodies[i].a);
-        body_system->bodies[i].v = body_system->bodies[i].p * body_system->bodies[i].shape->get_inv_mass();
-        body_system->bodies[i].i_inv =
-                body_system->bodies[i].a * body_system->bodies[i].shape->get_inv_moment_of_inertia() *
-                glm::transpose(body_system->bodies[i].a);
-        body_system->bodies[i].omega = body_system->bodies[i].i_inv * body_system->bodies[i].l;
+/** Sets the state of {s} to the state at the start of the step plus {weight} times the change. */
+void apply_delta(BodyState *s, double weight)
+{
+    for (uint32_t i = 0; i < s->size(); i++) {
+        s->x[i] = s->x_0[i] + weight * s->x_delta[i];
+        s->p[i] = s->p_0[i] + weight * s->p_delta[i];
+        s->q[i] = s->q_0[i] + weight * s->q_delta[i];
+        s->l[i] = s->l_0[i] + weight * s->l_delta[i];
+
+        s->q[i] = glm::normalize(s->q[i]);
+        s->compute_auxiliary(i);
     }
+}
 
-    // calculate hf(x0 + k1/2, t0 + dt/2)
-    for (auto &body : body_system->bodies) {
-        // compute the change in variables
-        body.x = dt * body.v;
-        body.p = dt * body.force;
-        body.a = dt * star(body.omega) * body.a;
-        body.l = dt * body.torque;
-
-//        body.a = glm::orthonormalize(body.a);
-
-        // compute change in auxiliary variables
-        body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
-        body.omega = body.i_inv * body.l;
+/** Adds {weight} times the change to the weighted sum of the changes, which starts at the state of the start. */
+void accumulate_delta(BodyState *s, double weight)
+{
+    for (uint32_t i = 0; i < s->size(); i++) {
+        s->x_sum[i] = s->x_sum[i] + weight * s->x_delta[i];
+        s->p_sum[i] = s->p_sum[i] + weight * s->p_delta[i];
+        s->q_sum[i] = s->q_sum[i] + weight * s->q_delta[i];
+        s->l_sum[i] = s->l_sum[i] + weight * s->l_delta[i];
     }
+}
 
-    std::vector<RigidBody> k2 = body_system->bodies;
-
-    /** k3 */
+/**
+ * Integrates {s} over {dt} from the quantities saved at the start of the step, which are also the start of the
+ * weighted sum. Only the arrays of {s} are used, which keep their capacity, such that this does not allocate. */
+void runge_kutta_4_state(BodyState *s, double dt)
+{
+    s->x_sum = s->x_0;
+    s->p_sum = s->p_0;
+    s->q_sum = s->q_0;
+    s->l_sum = s->l_0;
 
-    // set state to x0 + k2/2
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        body_system->bodies[i].x = initial_state[i].x + .5 * k2[i].x;
-        body_system->bodies[i].p = initial_state[i].p + .5 * k2[i].p;
-        body_system->bodies[i].a = initial_state[i].a + .5 * k2[i].a;
-        body_system->bodies[i].l = initial_state[i].l + .5 * k2[i].l;
+    const double F16 = 1. / 6.;
+    const double F13 = 1. / 3.;
 
-        body_system->bodies[i].a = glm::orthonormalize(body_system->bodies[i].a);
-        body_system->bodies[i].v = body_system->bodies[i].p * body_system->bodies[i].shape->get_inv_mass();
-        body_system->bodies[i].i_inv =
-                body_system->bodies[i].a * body_system->bodies[i].shape->get_inv_moment_of_inertia() *
-                glm::transpose(body_system->bodies[i].a);
-        body_system->bodies[i].omega = body_system->bodies[i].i_inv * body_system->bodies[i].l;
-    }
+    /** k1 */
 
+    // calculate hf(x0, t0)
+    compute_delta(s, dt);
+    accumulate_delta(s, F16);
 
-    // calculate hf(x0 + k2/2, t0 + dt/2)
-    for (auto &body : body_system->bodies) {
-        // compute the change in variables
-        body.x = dt * body.v;
-        body.p = dt * body.force;
-        body.a = dt * star(body.omega) * body.a;
-        body.l = dt * body.torque;
+    /** k2 */
 
-//        body.a = glm::orthonormalize(body.a);
+    // set state to x0 + k1/2 and calculate hf(x0 + k1/2, t0 + dt/2)
+    apply_delta(s, .5);
+    compute_delta(s, dt);
+    accumulate_delta(s, F13);
 
-        // compute change in auxiliary variables
-        body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
-        body.omega = body.i_inv * body.l;
-    }
+    /** k3 */
 
-    std::vector<RigidBody> k3 = body_system->bodies;
+    // set state to x0 + k2/2 and calculate hf(x0 + k2/2, t0 + dt/2)
+    apply_delta(s, .5);
+    compute_delta(s, dt);
+    accumulate_delta(s, F13);
 
     /** k4 */
 
-    // set state to x0 + k3
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        body_system->bodies[i].x = initial_state[i].x + k3[i].x;
-        body_system->bodies[i].p = initial_state[i].p + k3[i].p;
-        body_system->bodies[i].a = initial_state[i].a + k3[i].a;
-        body_system->bodies[i].l = initial_state[i].l + k3[i].l;
-
-        body_system->bodies[i].a = glm::orthonormalize(body_system->bodies[i].a);
-        body_system->bodies[i].v = body_system->bodies[i].p * body_system->bodies[i].shape->get_inv_mass();
-        body_system->bodies[i].i_inv =
-                body_system->bodies[i].a * body_system->bodies[i].shape->get_inv_moment_of_inertia() *
-                glm::transpose(body_system->bodies[i].a);
-        body_system->bodies[i].omega = body_system->bodies[i].i_inv * body_system->bodies[i].l;
-    }
+    // set state to x0 + k3 and calculate hf(x0 + k3, t0 + h)
+    apply_delta(s, 1.);
+    compute_delta(s, dt);
 
-    // calculate hf(x0 + k3, t0 + h)
-    for (auto &body : body_system->bodies) {
-        // compute the change in variables
-        body.x = dt * body.v;
-        body.p = dt * body.force;
-        body.a = dt * star(body.omega) * body.a;
-        body.l = dt * body.torque;
+    /** perform update */
 
-//        body.a = glm::orthonormalize(body.a);
+    // update the bodies to time t0 + h, as x0 + k1/6 + k2/3 + k3/3 + k4/6
+    for (uint32_t i = 0; i < s->size(); i++) {
+        s->x[i] = s->x_sum[i] + F16 * s->x_delta[i];
+        s->p[i] = s->p_sum[i] + F16 * s->p_delta[i];
+        s->q[i] = s->q_sum[i] + F16 * s->q_delta[i];
+        s->l[i] = s->l_sum[i] + F16 * s->l_delta[i];
 
-        // compute change in auxiliary variables
-        body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
-        body.omega = body.i_inv * body.l;
+        s->q[i] = glm::normalize(s->q[i]);
+        s->compute_auxiliary(i);
     }
+}
 
-    std::vector<RigidBody> k4 = body_system->bodies;
-
-    /** perform update */
+void Integrator::runge_kutta_4(BodySystem *body_system, double dt)
+{
+    BodyState *s = &body_system->body_state;
 
-    // update the bodies to time t0 + h
-    const double F16 = 1. / 6.;
-    const double F13 = 1. / 3.;
-    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
-        body_system->bodies[i].x = initial_state[i].x + F16 * k1[i].x + F13 * k2[i].x + F13 * k3[i].x + F16 * k4[i].x;
-        body_system->bodies[i].p = initial_state[i].p + F16 * k1[i].p + F13 * k2[i].p + F13 * k3[i].p + F16 * k4[i].p;
+    // save the state at t0
+    s->x_0 = s->x;
+    s->p_0 = s->p;
+    s->q_0 = s->q;
+    s->l_0 = s->l;
+    s->v_0 = s->v;
+    s->omega_0 = s->omega;
+
+    runge_kutta_4_state(s, dt);
+    s->store_state(&body_system->bodies);
+}
 
-        body_system->bodies[i].a = initial_state[i].a + F16 * k1[i].a + F13 * k2[i].a + F13 * k3[i].a + F16 * k4[i].a;
-        body_system->bodies[i].l = initial_state[i].l + F16 * k1[i].l + F13 * k2[i].l + F13 * k3[i].l + F16 * k4[i].l;
+void Integrator::repeat_runge_kutta_4(BodySystem *body_system, double dt)
+{
+    BodyState *s = &body_system->body_state;
+
+    // restore the state at t0, the forces are unchanged
+    s->x = s->x_0;
+    s->p = s->p_0;
+    s->q = s->q_0;
+    s->l = s->l_0;
+    s->v = s->v_0;
+    s->omega = s->omega_0;
+
+    runge_kutta_4_state(s, dt);
+    s->store_state(&body_system->bodies);
+}
 
-        body_system->bodies[i].a = glm::orthonormalize(body_system->bodies[i].a);
-        body_system->bodies[i].v = body_system->bodies[i].p * body_system->bodies[i].shape->get_inv_mass();
-        body_system->bodies[i].i_inv =
-                body_system->bodies[i].a * body_system->bodies[i].shape->get_inv_moment_of_inertia() *
-                glm::transpose(body_system->bodies[i].a);
-        body_system->bodies[i].omega = body_system->bodies[i].i_inv * body_system->bodies[i].l;
+bool Integrator::has_progressed(BodySystem *body_system)
+{
+    const BodyState &s = body_system->body_state;
+    for (uint32_t i = 0; i < s.size(); i++) {
+        const RigidBody &body = body_system->bodies[s.index[i]];
+        if (body.x != s.x_0[i] || body.p != s.p_0[i] || body.q != s.q_0[i] || body.l != s.l_0[i]) return true;
     }
+
+    return false;
 }
 
 void Integrator::midpoint(BodySystem *body_system, double dt)
@@ -186,22 +174,23 @@ void Integrator::midpoint(BodySystem *body_system, double dt)
 
     // update to time t0 + h
     for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
+        if (body_system->bodies[i].asleep) continue;
+
         body_system->bodies[i].x = initial_state[i].x + dt * body_system->bodies[i].v;
         body_system->bodies[i].p = initial_state[i].p + dt * body_system->bodies[i].force;
 
-        body_system->bodies[i].a =
-                initial_state[i].a + dt * star(body_system->bodies[i].omega) * body_system->bodies[i].a;
+        body_system->bodies[i].q =
+                initial_state[i].q + dt * spin(body_system->bodies[i].omega, body_system->bodies[i].q);
         body_system->bodies[i].l = initial_state[i].l + dt * body_system->bodies[i].torque;
 
-        // todo use a quaternion
-        body_system->bodies[i].a = glm::orthonormalize(body_system->bodies[i].a);
+        body_system->bodies[i].q = glm::normalize(body_system->bodies[i].q);
 
         // compute auxiliary quantities
         body_system->bodies[i].v =
                 body_system->bodies[i].p * body_system->bodies[i].shape->get_inv_mass();
+        glm::dmat3 a = body_system->bodies[i].get_rotation();
         body_system->bodies[i].i_inv =
-                body_system->bodies[i].a * body_system->bodies[i].shape->get_inv_moment_of_inertia() *
-                glm::transpose(body_system->bodies[i].a);
+                a * body_system->bodies[i].shape->get_inv_moment_of_inertia() * glm::transpose(a);
         body_system->bodies[i].omega =
                 body_system->bodies[i].i_inv * body_system->bodies[i].l;
     }
@@ -211,19 +200,21 @@ void Integrator::integrate(BodySystem *body_system, double dt)
 {
     // perform an Euler step
     for (auto &body : body_system->bodies) {
+        if (body.asleep) continue;
+
         // integrate quantities
         body.x += dt * body.v;
         body.p += dt * body.force;
 
-        body.a += dt * star(body.omega) * body.a;
+        body.q += dt * spin(body.omega, body.q);
         body.l += dt * body.torque;
 
-        // todo use a quaternion
-        body.a = glm::orthonormalize(body.a);
+        body.q = glm::normalize(body.q);
 
         // compute auxiliary quantities
         body.v = body.p * body.shape->get_inv_mass();
-        body.i_inv = body.a * body.shape->get_inv_moment_of_inertia() * glm::transpose(body.a);
+        glm::dmat3 a = body.get_rotation();
+        body.i_inv = a * body.shape->get_inv_moment_of_inertia() * glm::transpose(a);
         body.omega = body.i_inv * body.l;
     }
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #ifndef SIMULATION_INTEGRATOR_HPP
 #define SIMULATION_INTEGRATOR_HPP
 
-#include <glm/gtx/orthonormalize.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include "body_system.hpp"
 
@@ -9,17 +9,33 @@ namespace Integrator {
     /** Performs midpoint integration. */
     void midpoint(BodySystem *body_system, double dt);
 
-    /** Performs fourth order Runge Kutta integration. */
+    /**
+     * Performs fourth order Runge Kutta integration on {BodySystem::body_state}, as loaded by {apply_forces} and
+     * with the contact forces added, and writes the result to the bodies. */
     void runge_kutta_4(BodySystem *body_system, double dt);
 
+    /**
+     * Repeats the last {runge_kutta_4} over {dt} instead, from the state the bodies had before it, without
+     * reading the bodies. Used to search the time of collision. */
+    void repeat_runge_kutta_4(BodySystem *body_system, double dt);
+
+    /** Whether the quantities of the bodies differ from those at the start of the last {runge_kutta_4}. */
+    bool has_progressed(BodySystem *body_system);
+
     /** Performs Euler integration. */
     void integrate(BodySystem *body_system, double dt);
 
     void clear_forces(BodySystem *body_system);
 
+    /**
+     * Loads {BodySystem::body_state} from the bodies, with zero force and torque, and applies all
+     * {BodySystem::forces} to it. */
     void apply_forces(BodySystem *body_system);
 
     glm::dmat3 star(glm::dvec3 a);
+
+    /** Derivative of orientation {q} of a body with angular velocity {omega}, equal to (0, omega) q / 2. */
+    glm::dquat spin(glm::dvec3 omega, glm::dquat q);
 }
 
 #endif //SIMULATION_INTEGRATOR_HPP
@@ -0,0 +1,84 @@
+#include <algorithm>
+
+#include "island.hpp"
+#include "contact.hpp"
+#include "collision_detection.hpp"
+
+UnionFind::UnionFind(
+        uint32_t n
+) :
+        parent(n), size(n, 1)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        parent[i] = i;
+    }
+}
+
+uint32_t UnionFind::find(uint32_t i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+
+    return i;
+}
+
+void UnionFind::unite(uint32_t i, uint32_t j)
+{
+    i = find(i);
+    j = find(j);
+    if (i == j) return;
+
+    if (size[i] < size[j]) std::swap(i, j);
+    parent[j] = i;
+    size[i] += size[j];
+}
+
+void IslandStatistics::add(uint32_t contacts)
+{
+    islands++;
+    largest = std::max(largest, contacts);
+
+    uint32_t k = 0;
+    while (contacts >> (k + 1u)) k++;
+    if (histogram.size() <= k) histogram.resize(k + 1, 0);
+    histogram[k]++;
+}
+
+void IslandStatistics::reset()
+{
+    calls = 0;
+    islands = 0;
+    largest = 0;
+    histogram.clear();
+}
+
+std::vector<std::vector<Contact *>> Island::find_islands(
+        const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies)
+{
+    // connect the movable bodies of every contact, bodies which are not moved in the current substep are immovable
+    UnionFind sets(bodies.size());
+    for (auto &contact : contacts) {
+        auto a = (uint32_t) (contact->body_a - bodies.data());
+        auto b = (uint32_t) (contact->body_b - bodies.data());
+        if (CollisionDetection::is_moving(contact->body_a) && CollisionDetection::is_moving(contact->body_b)) {
+            sets.unite(a, b);
+        }
+    }
+
+    // the island of a contact is that of its movable body
+    std::vector<std::vector<Contact *>> islands;
+    std::vector<uint32_t> island_of(bodies.size(), UINT32_MAX);
+    for (auto &contact : contacts) {
+        RigidBody *body = CollisionDetection::is_moving(contact->body_a) ? contact->body_a : contact->body_b;
+        uint32_t root = sets.find((uint32_t) (body - bodies.data()));
+        if (island_of[root] == UINT32_MAX) {
+            island_of[root] = islands.size();
+            islands.emplace_back();
+        }
+        islands[island_of[root]].emplace_back(contact);
+    }
+
+    return islands;
+}
@@ -0,0 +1,58 @@
+#ifndef SIMULATION_ISLAND_HPP
+#define SIMULATION_ISLAND_HPP
+
+#include <vector>
+#include <cstdint>
+
+class RigidBody;
+
+class Contact;
+
+/** Disjoint sets of the integers in [0, n), with path halving and union by size. */
+class UnionFind {
+private:
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> size;
+public:
+    explicit UnionFind(uint32_t n);
+
+    /** Representative of the set containing {i}. */
+    uint32_t find(uint32_t i);
+
+    /** Merges the sets containing {i} and {j}. */
+    void unite(uint32_t i, uint32_t j);
+};
+
+/** Number and sizes of the islands of {Island::find_islands}, accumulated over calls. */
+struct IslandStatistics {
+    /** Number of calls. */
+    uint64_t calls = 0;
+
+    /** Number of islands, over all calls. */
+    uint64_t islands = 0;
+
+    /** Number of contacts in the largest island. */
+    uint32_t largest = 0;
+
+    /** Element {k} is the number of islands with at least 2^k and fewer than 2^(k+1) contacts. */
+    std::vector<uint64_t> histogram;
+
+    /** Adds an island of {contacts} contacts. */
+    void add(uint32_t contacts);
+
+    void reset();
+};
+
+namespace Island {
+    /**
+     * Partitions {contacts} into islands, which are groups of contacts that are connected through movable bodies.
+     * Bodies with zero inverse mass and bodies which are not moved in the current substep, see
+     * {CollisionDetection::is_moving}, do not connect contacts, as no contact force moves them. As the forces of
+     * different islands do not influence each other, the islands can be solved separately. The order of
+     * {contacts} is kept within every island, and the islands are ordered by their first contact.
+     * {bodies} is {BodySystem::bodies}. */
+    std::vector<std::vector<Contact *>> find_islands(
+            const std::vector<Contact *> &contacts, const std::vector<RigidBody> &bodies);
+}
+
+#endif //SIMULATION_ISLAND_HPP
@@ -38,63 +38,40 @@ void math::maxstep(
     }
 }
 
-void math::fdirection(double *fvec_delta, const double *amat, const bool *c, uint32_t n, uint32_t d)
+void math::fdirection(
+        double *fvec_delta, const SparseMatrix &amat, SolverWorkspace *workspace, const bool *c, uint32_t n,
+        uint32_t d)
 {
     memset(fvec_delta, 0., n * sizeof(double)); // Delta f = 0
     fvec_delta[d] = 1.;                         // Delta f_d = 1
 
-    uint32_t c_count = 0; // the amount of indices in C
-    for (uint32_t i = 0; i < n; i++) {
-        if (c[i]) c_count++;
-    }
-
-    if (c_count == 0) return; // no work to be done
+    if (workspace->factor.size() == 0) return; // no work to be done
 
-    // A_11 = A_CC
-    auto amat_11 = (double *) malloc(c_count * c_count * sizeof(double));
-    uint32_t amat_11_index = 0;
-    for (uint32_t i = 0; i < n; i++) {
-        for (uint32_t j = 0; j < n; j++) {
-            if (c[i] && c[j]) amat_11[amat_11_index++] = amat[i * n + j];
-        }
+    // -v_1 = -A_Cd, which is row d as A is symmetric
+    double *vvec_1 = workspace->vvec_1.data();
+    memset(vvec_1, 0., n * sizeof(double));
+    for (uint32_t k = amat.row_start[d]; k < amat.row_start[d + 1]; k++) {
+        if (c[amat.columns[k]]) vvec_1[amat.columns[k]] = -amat.values[k];
     }
 
-    assert(amat_11_index == c_count * c_count);
-
-    // -v_1 = -A_Cd
-    auto vvec_1 = (double *) malloc(c_count * sizeof(double));
-    uint32_t vvec_1_index = 0;
-    for (uint32_t i = 0; i < n; i++) {
-        if (c[i]) vvec_1[vvec_1_index++] = -amat[i * n + d];
-    }
-
-    assert(vvec_1_index == c_count);
-
-    // solve A_11 * x = -v_1
-    auto x = (double *) malloc(c_count * sizeof(double));
-    lp_solve(amat_11, x, vvec_1, c_count);
-
-    // transfer x into Delta f
-    uint32_t x_index = 0;
-    for (uint32_t i = 0; i < n; i++) {
-        if (c[i]) fvec_delta[i] = x[x_index++];
-    }
-
-    free(x);
-    free(vvec_1);
-    free(amat_11);
+    // solve A_11 * x = -v_1, directly into Delta f
+    workspace->factor.solve(fvec_delta, vvec_1);
 }
 
-void math::drive_to_zero(
-        const double *amat, double *avec, double *fvec, bool *c, bool *nc, uint32_t n, uint32_t d)
+uint32_t math::drive_to_zero(
+        const SparseMatrix &amat, SolverWorkspace *workspace, double *avec, double *fvec, bool *c, bool *nc,
+        uint32_t n, uint32_t d)
 {
-    auto fvec_delta = (double *) malloc(n * sizeof(double));
-    auto avec_delta = (double *) malloc(n * sizeof(double));
+    double *fvec_delta = workspace->fvec_delta.data();
+    double *avec_delta = workspace->avec_delta.data();
+    LdltFactor *factor = &workspace->factor;
     double s;
     uint32_t j;
+    uint32_t pivots = 0;
 
     l1:
-    fdirection(fvec_delta, amat, c, n, d);        // Delta f = fdirection(d)
+    pivots++;
+    fdirection(fvec_delta, amat, workspace, c, n, d); // Delta f = fdirection(d)
 
     for (uint32_t i = 0; i < n; i++) {
         if (c[i] && fvec[i] == 0. && fvec_delta[i] < 0.) {
@@ -102,7 +79,7 @@ void math::drive_to_zero(
         }
     }
 
-    mat_mul_vec(avec_delta, amat, fvec_delta, n); // Delta a = A * Delta f
+    mat_mul_vec(avec_delta, amat, fvec_delta);    // Delta a = A * Delta f
 
     for (uint32_t i = 0; i < n; i++) {
         if (nc[i] && avec[i] == 0. && avec_delta[i] < 0.) {
@@ -121,27 +98,112 @@ void math::drive_to_zero(
     if (c[j]) {         // if j in C
         c[j] = false;   // C = C - {j}
         nc[j] = true;   // NC = NC U {j}
+        factor->remove(j);
         goto l1;
     } else if (nc[j]) { // else if j in NC
         nc[j] = false;  // NC = NC - {j}
         c[j] = true;    // C = C U {j}
+        factor->add(j);
         goto l1;
     } else { // j must be d, implying a_d = 0
         c[j] = true;    // C = C U {j}
+        factor->add(j);
     }
 
-    free(avec_delta);
-    free(fvec_delta);
+    return pivots;
 }
 
-void math::qp_solve(const double *amat, const double *bvec, double *fvec, uint32_t n)
+bool math::warm_start(
+        const SparseMatrix &amat, SolverWorkspace *workspace, const double *bvec, double *avec, double *fvec,
+        bool *c, uint32_t n)
 {
-    memset(fvec, 0., n * sizeof(double));       // f = 0
-    auto avec = (double *) malloc(n * sizeof(double));
-    memcpy(avec, bvec, n * sizeof(double));      // a = b
+    LdltFactor *factor = &workspace->factor;
+    bool *clamped = workspace->clamped.get();
+    for (uint32_t i = 0; i < n; i++) {
+        clamped[i] = fvec[i] > 0.;
+        if (clamped[i]) factor->add(i);
+    }
 
-    auto c = (bool *) calloc(n, sizeof(bool));  // C = emptyset
-    auto nc = (bool *) calloc(n, sizeof(bool)); // NC = emptyset
+    // -b
+    double *vvec_1 = workspace->vvec_1.data();
+    for (uint32_t i = 0; i < n; i++) {
+        vvec_1[i] = -bvec[i];
+    }
+
+    double *fvec_guess = workspace->fvec_guess.data();
+    memset(fvec_guess, 0., n * sizeof(double));
+    bool found = false;
+    bool done = false;
+    while (!done) {
+        if (factor->size() == 0) break; // no guess remains
+
+        // solve A_CC * x = -b_C
+        factor->solve(fvec_guess, vvec_1);
+
+        // unclamp the contacts which would pull
+        done = true;
+        for (uint32_t i = 0; i < n; i++) {
+            if (!clamped[i]) continue;
+            if (!(fvec_guess[i] > 0.)) {
+                clamped[i] = false;
+                fvec_guess[i] = 0.;
+                factor->remove(i);
+                done = false;
+            }
+        }
+
+        found = done;
+    }
+
+    if (found) {
+        // the accelerations of the clamped contacts are zero up to rounding, unless A_CC is singular
+        double *avec_guess = workspace->avec_guess.data();
+        mat_mul_vec(avec_guess, amat, fvec_guess);
+        vec_add_equal(n, avec_guess, bvec);
+
+        double scale = 1.;
+        for (uint32_t i = 0; i < n; i++) {
+            scale = std::max(scale, fabs(bvec[i]));
+        }
+
+        const double TOLERANCE = 1.e-9;
+        for (uint32_t i = 0; i < n; i++) {
+            if (clamped[i] && fabs(avec_guess[i]) > TOLERANCE * scale) found = false;
+        }
+
+        if (found) {
+            for (uint32_t i = 0; i < n; i++) {
+                c[i] = clamped[i];
+                fvec[i] = clamped[i] ? fvec_guess[i] : 0.;
+                avec[i] = clamped[i] ? 0. : avec_guess[i];
+            }
+        }
+    }
+
+    if (!found) factor->clear();
+
+    return found;
+}
+
+uint32_t math::qp_solve(
+        const SparseMatrix &amat, const double *bvec, double *fvec, uint32_t n, SolverWorkspace *workspace)
+{
+    workspace->reserve(n);
+
+    double *avec = workspace->avec.data();
+    memcpy(avec, bvec, n * sizeof(double));     // a = b
+
+    bool *c = workspace->c.get();
+    bool *nc = workspace->nc.get();
+    memset(c, 0, n * sizeof(bool));             // C = emptyset
+    memset(nc, 0, n * sizeof(bool));            // NC = emptyset
+
+    workspace->factor.reset(&amat);             // factorization of A_CC
+    if (!warm_start(amat, workspace, bvec, avec, fvec, c, n)) {
+        memset(fvec, 0., n * sizeof(double));   // f = 0
+    }
+
+    uint32_t pivots = 0;
 
     // while exists d such that a_d < 0
     bool done;
@@ -153,7 +215,7 @@ void math::qp_solve(const double *amat, const double *bvec, double *fvec, uint32
             const double THRESHOLD = -1.e-14;
             if (avec[d] < THRESHOLD) {
                 // drive-to-zero(d)
-                drive_to_zero(amat, avec, fvec, c, nc, n, d);
+                pivots += drive_to_zero(amat, workspace, avec, fvec, c, nc, n, d);
                 if (avec[d] < THRESHOLD) {
                     assert(0);
                 }
@@ -163,9 +225,245 @@ void math::qp_solve(const double *amat, const double *bvec, double *fvec, uint32
         }
     } while (!done);
 
-    free(nc);
-    free(c);
-    free(avec);
+    return pivots;
+}
+
+uint32_t math::pgs_solve(
+        const SparseMatrix &amat, const double *bvec, double *fvec, uint32_t n, uint32_t max_iterations,
+        double tolerance, SolverWorkspace *workspace)
+{
+    workspace->reserve(n);
+    double *avec = workspace->avec.data();
+
+    for (uint32_t i = 0; i < n; i++) {
+        fvec[i] = std::max(fvec[i], 0.);
+    }
+
+    uint32_t iteration = 0;
+    while (iteration < max_iterations && lcp_residual(amat, bvec, fvec, avec, n) > tolerance) {
+        iteration++;
+        for (uint32_t i = 0; i < n; i++) {
+            // a_i = A_i * f + b_i, with the forces updated so far in this sweep
+            double a_ii = 0.;
+            double a_i = bvec[i];
+            for (uint32_t k = amat.row_start[i]; k < amat.row_start[i + 1]; k++) {
+                a_i += amat.values[k] * fvec[amat.columns[k]];
+                if (amat.columns[k] == i) a_ii = amat.values[k];
+            }
+
+            // a contact between bodies which cannot be accelerated takes no force
+            if (a_ii <= 0.) continue;
+
+            fvec[i] = std::max(fvec[i] - a_i / a_ii, 0.);
+        }
+    }
+
+    return iteration;
+}
+
+double math::lcp_residual(const SparseMatrix &amat, const double *bvec, const double *fvec, double *avec, uint32_t n)
+{
+    mat_mul_vec(avec, amat, fvec);
+    vec_add_equal(n, avec, bvec);
+
+    double residual = 0.;
+    for (uint32_t i = 0; i < n; i++) {
+        residual = std::max(residual, fabs(std::min(fvec[i], avec[i])));
+    }
+
+    return residual;
+}
+
+void math::SolverWorkspace::reserve(uint32_t n)
+{
+    if (n <= capacity) return;
+
+    capacity = n;
+    avec.resize(n);
+    fvec_delta.resize(n);
+    avec_delta.resize(n);
+    vvec_1.resize(n);
+    fvec_guess.resize(n);
+    avec_guess.resize(n);
+    c.reset(new bool[n]);
+    nc.reset(new bool[n]);
+    clamped.reset(new bool[n]);
+    factor.reserve(n);
+}
+
+std::array<size_t, math::SolverWorkspace::BUFFERS> math::SolverWorkspace::get_capacities() const
+{
+    std::array<size_t, BUFFERS> capacities = {
+            amat.row_start.capacity(), amat.columns.capacity(), amat.values.capacity(), bvec.capacity(),
+            fvec.capacity(), body_contacts.capacity(), columns.capacity(), avec.capacity(), fvec_delta.capacity(),
+            avec_delta.capacity(), vvec_1.capacity(), fvec_guess.capacity(), avec_guess.capacity(),
+            // {c}, {nc} and {clamped} are allocated with {capacity} entries
+            capacity, capacity, capacity
+    };
+    std::array<size_t, LdltFactor::BUFFERS> factor_capacities = factor.get_capacities();
+    std::copy(factor_capacities.begin(), factor_capacities.end(), capacities.end() - LdltFactor::BUFFERS);
+
+    return capacities;
+}
+
+void math::SolverWorkspace::count_allocations(const std::array<size_t, BUFFERS> &before)
+{
+    std::array<size_t, BUFFERS> after = get_capacities();
+    for (uint32_t i = 0; i < BUFFERS; i++) {
+        if (after[i] != before[i]) allocations++;
+    }
+}
+
+void math::LdltFactor::reset(const SparseMatrix *p_amat)
+{
+    amat = p_amat;
+    row.assign(amat->n, 0.);
+    clear();
+}
+
+void math::LdltFactor::reserve(uint32_t n)
+{
+    indices.reserve(n);
+    l.reserve(n * (n - 1) / 2);
+    d.reserve(n);
+    row.reserve(n);
+    scratch.reserve(n);
+}
+
+bool math::LdltFactor::is_dependent(double d_r, double a_rr)
+{
+    return d_r <= PIVOT_TOLERANCE * a_rr;
+}
+
+std::array<size_t, math::LdltFactor::BUFFERS> math::LdltFactor::get_capacities() const
+{
+    return {{indices.capacity(), l.capacity(), d.capacity(), row.capacity(), scratch.capacity()}};
+}
+
+uint32_t math::LdltFactor::size() const
+{
+    return indices.size();
+}
+
+void math::LdltFactor::add(uint32_t i)
+{
+    uint32_t m = indices.size();
+    uint32_t start = m * (m - 1) / 2;
+    l.resize(start + m);
+    double *l_new = l.data() + start;
+
+    // the new column of A_CC
+    for (uint32_t k = amat->row_start[i]; k < amat->row_start[i + 1]; k++) {
+        row[amat->columns[k]] = amat->values[k];
+    }
+
+    // solve L * y = A_Ci, then the new row of L is y / D and the new entry of D is A_ii - y^T * D^-1 * y
+    double d_new = row[i];
+    for (uint32_t r = 0; r < m; r++) {
+        const double *l_r = l.data() + r * (r - 1) / 2;
+        double y = row[indices[r]];
+        for (uint32_t k = 0; k < r; k++) {
+            y -= l_r[k] * l_new[k];
+        }
+        l_new[r] = y;
+    }
+    for (uint32_t r = 0; r < m; r++) {
+        // a dependent row contributes nothing, y is zero along it up to rounding
+        double y = l_new[r];
+        l_new[r] = d[r] == 0. ? 0. : y / d[r];
+        d_new -= y * l_new[r];
+    }
+    if (is_dependent(d_new, row[i])) d_new = 0.;
+
+    for (uint32_t k = amat->row_start[i]; k < amat->row_start[i + 1]; k++) {
+        row[amat->columns[k]] = 0.;
+    }
+
+    indices.emplace_back(i);
+    d.emplace_back(d_new);
+}
+
+void math::LdltFactor::remove(uint32_t i)
+{
+    auto p = (uint32_t) (std::find(indices.begin(), indices.end(), i) - indices.begin());
+    assert(p < indices.size());
+
+    // remove row and column p in place, keeping the column of L below row p which is lost by it
+    uint32_t m = indices.size() - 1;
+    scratch.resize(m - p);
+    double *w = scratch.data();
+    uint32_t write = p * (p - 1) / 2;
+    for (uint32_t r = p + 1; r <= m; r++) {
+        uint32_t read = r * (r - 1) / 2;
+        for (uint32_t k = 0; k < r; k++) {
+            if (k == p) {
+                w[r - p - 1] = l[read + k];
+            } else {
+                l[write++] = l[read + k];
+            }
+        }
+    }
+    l.resize(write);
+    double alpha = d[p];
+    indices.erase(indices.begin() + p);
+    d.erase(d.begin() + p);
+
+    // the trailing rows factorized L_22 * D_22 * L_22^T, now add alpha * w * w^T to it
+    for (uint32_t j = p; j < m; j++) {
+        double wj = w[j - p];
+        double d_new = d[j] + alpha * wj * wj;
+        if (is_dependent(d_new, amat->get(indices[j], indices[j]))) {
+            // the row stays dependent, w has no component along it
+            d[j] = 0.;
+            continue;
+        }
+        double beta = wj * alpha / d_new;
+        alpha = d[j] * alpha / d_new;
+        d[j] = d_new;
+        for (uint32_t r = j + 1; r < m; r++) {
+            double *l_r = l.data() + r * (r - 1) / 2;
+            w[r - p] -= wj * l_r[j];
+            l_r[j] += beta * w[r - p];
+        }
+    }
+}
+
+void math::LdltFactor::clear()
+{
+    indices.clear();
+    l.clear();
+    d.clear();
+}
+
+void math::LdltFactor::solve(double *x, const double *b)
+{
+    uint32_t m = indices.size();
+    scratch.resize(m);
+    double *z = scratch.data();
+
+    // L * z = b
+    for (uint32_t r = 0; r < m; r++) {
+        const double *l_r = l.data() + r * (r - 1) / 2;
+        double sum = b[indices[r]];
+        for (uint32_t k = 0; k < r; k++) {
+            sum -= l_r[k] * z[k];
+        }
+        z[r] = sum;
+    }
+
+    // D * L^T * x = z
+    for (uint32_t r = m; r-- > 0;) {
+        // a dependent row takes no part in the solution, its equation follows from the rows before it
+        double sum = d[r] == 0. ? 0. : z[r] / d[r];
+        for (uint32_t k = r + 1; k < m; k++) {
+            sum -= l[k * (k - 1) / 2 + r] * z[k];
+        }
+        z[r] = sum;
+    }
+
+    for (uint32_t r = 0; r < m; r++) {
+        x[indices[r]] = z[r];
+    }
 }
 
 void math::mat_mul_vec(double *res, const double *mat, const double *vec, uint32_t n)
@@ -178,6 +476,27 @@ void math::mat_mul_vec(double *res, const double *mat, const double *vec, uint32
     }
 }
 
+void math::mat_mul_vec(double *res, const SparseMatrix &mat, const double *vec)
+{
+    for (uint32_t i = 0; i < mat.n; i++) {
+        double sum = 0.;
+        for (uint32_t k = mat.row_start[i]; k < mat.row_start[i + 1]; k++) {
+            sum += mat.values[k] * vec[mat.columns[k]];
+        }
+        res[i] = sum;
+    }
+}
+
+double math::SparseMatrix::get(uint32_t i, uint32_t j) const
+{
+    auto begin = columns.begin() + row_start[i];
+    auto end = columns.begin() + row_start[i + 1];
+    auto it = std::lower_bound(begin, end, j);
+    if (it == end || *it != j) return 0.;
+
+    return values[it - columns.begin()];
+}
+
 void math::vec_add_equal(uint32_t n, double *r, const double *v)
 {
     for (uint32_t i = 0; i < n; i++) {
@@ -9,11 +9,138 @@
 #include <cstdio>
 #include <limits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <array>
 
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_linalg.h>
 
 namespace math {
+    /**
+     * Square matrix in compressed sparse row format. The entries of row {i} are at the indices from
+     * {row_start[i]} up to {row_start[i + 1]} of {columns} and {values}, with ascending columns. Entries which are
+     * not stored are zero. */
+    struct SparseMatrix {
+        uint32_t n = 0;
+        std::vector<uint32_t> row_start;
+        std::vector<uint32_t> columns;
+        std::vector<double> values;
+
+        /** Entry at row {i} and column {j}. */
+        double get(uint32_t i, uint32_t j) const;
+    };
+
+    /**
+     * LDL^T factorization of A_CC, the submatrix of a symmetric matrix A formed by the rows and columns in the set
+     * C. As C changes by one index at a time in {drive_to_zero}, the factorization is updated in O(c^2) for c
+     * indices in C, instead of factorizing A_CC again in O(c^3). A is positive semi-definite, and A_CC is singular
+     * for instance when more than three contacts lie on the same face of a body. A row of which the entry of D
+     * falls below {PIVOT_TOLERANCE} relative to its diagonal entry of A depends on the rows before it, as with the
+     * pivoted Cholesky decomposition of {lp_solve}. Its entry of D is set to zero, and it is left out of {solve}. */
+    class LdltFactor {
+    private:
+        /** Entry of D relative to the diagonal entry of A below which a row is dependent. */
+        static constexpr double const PIVOT_TOLERANCE = 1.e-10;
+
+        const SparseMatrix *amat = nullptr;
+
+        /** The indices in C, in the order of the rows of the factorization. */
+        std::vector<uint32_t> indices;
+
+        /** The unit lower triangular L without the diagonal, packed by rows such that row r starts at r(r-1)/2. */
+        std::vector<double> l;
+
+        /** The diagonal D. */
+        std::vector<double> d;
+
+        /** Row of {amat} scattered to a dense vector, to look up entries in O(1). */
+        std::vector<double> row;
+
+        /** Scratch vector of {remove} and {solve}. */
+        std::vector<double> scratch;
+
+        /** Whether a row with entry {d_r} of D and diagonal entry {a_rr} of A depends on the rows before it. */
+        static bool is_dependent(double d_r, double a_rr);
+    public:
+        /** Starts factorizing {p_amat} with C = emptyset. */
+        void reset(const SparseMatrix *p_amat);
+
+        /** Allocates the storage for C to grow to {n} indices, such that {add} does not allocate. */
+        void reserve(uint32_t n);
+
+        /** Number of indices in C. */
+        uint32_t size() const;
+
+        /** C = C U {i}, appending a row and column to the factorization. */
+        void add(uint32_t i);
+
+        /** C = C - {i}, followed by a rank one update of the rows after that of {i}. */
+        void remove(uint32_t i);
+
+        /** C = emptyset */
+        void clear();
+
+        /** Number of buffers reported by {get_capacities}. */
+        static const uint32_t BUFFERS = 5;
+
+        /** Capacity of every buffer, to detect that one of them grew. */
+        std::array<size_t, BUFFERS> get_capacities() const;
+
+        /**
+         * Solves A_CC * x_C = b_C, where {x} and {b} are indexed as A. Only the entries in C are read and written.
+         * If A_CC is singular, this is one of the solutions, provided that there is one. */
+        void solve(double *x, const double *b);
+    };
+
+    /**
+     * Buffers of {qp_solve} and of the assembly of its problem, which are reused for every solve. They grow to
+     * the largest problem solved, after which solving does not allocate. */
+    struct SolverWorkspace {
+        /**
+         * Number of buffers below which had to grow during a solve, summed over all solves, for testing that
+         * solving does not allocate. Counted by {CollisionHandling::solve_contact_forces}, see
+         * {count_allocations}. */
+        uint64_t allocations = 0;
+
+        /** Largest problem the buffers of {qp_solve} fit. */
+        uint32_t capacity = 0;
+
+        /** Problem: A, b and f. */
+        SparseMatrix amat;
+        std::vector<double> bvec;
+        std::vector<double> fvec;
+
+        /** Scratch of the assembly of {amat}: contact indices by body and the columns of a row. */
+        std::vector<std::pair<const void *, uint32_t>> body_contacts;
+        std::vector<uint32_t> columns;
+
+        /** Buffers of {qp_solve} and its helpers. */
+        std::vector<double> avec;
+        std::vector<double> fvec_delta;
+        std::vector<double> avec_delta;
+        std::vector<double> vvec_1;
+        std::vector<double> fvec_guess;
+        std::vector<double> avec_guess;
+        std::unique_ptr<bool[]> c;
+        std::unique_ptr<bool[]> nc;
+        std::unique_ptr<bool[]> clamped;
+        LdltFactor factor;
+
+        /** Grows the buffers of {qp_solve} to fit a problem of size {n}. */
+        void reserve(uint32_t n);
+
+        /** Number of buffers reported by {get_capacities}. */
+        static const uint32_t BUFFERS = 16 + LdltFactor::BUFFERS;
+
+        /** Capacity of every buffer, including those of {factor}, to detect that one of them grew. */
+        std::array<size_t, BUFFERS> get_capacities() const;
+
+        /** Adds the number of buffers of which the capacity changed since {before} to {allocations}. */
+        void count_allocations(const std::array<size_t, BUFFERS> &before);
+    };
+
     /** Implementation of "maxstep" of Ref. 2.*/
     void maxstep(
             double *s, uint32_t *j, const double *fvec, const double *avec,
@@ -21,16 +148,48 @@ namespace math {
             const bool *c, const bool *nc, uint32_t n, uint32_t d
     );
 
-    /** Implementation of "drive_to_zero" of Ref. 2.*/
-    void fdirection(double *fvec_delta, const double *amat, const bool *c, uint32_t n, uint32_t d);
+    /** Implementation of "fdirection" of Ref. 2. {SolverWorkspace::factor} factorizes A_CC.*/
+    void fdirection(
+            double *fvec_delta, const SparseMatrix &amat, SolverWorkspace *workspace, const bool *c, uint32_t n,
+            uint32_t d);
 
-    /** Implementation of "drive_to_zero" of Ref. 2.*/
-    void drive_to_zero(
-            const double *amat, double *avec, double *fvec, bool *c, bool *nc, uint32_t n, uint32_t d
+    /** Implementation of "drive_to_zero" of Ref. 2. {SolverWorkspace::factor} is kept up to date with C. Returns
+     *  the number of pivots.*/
+    uint32_t drive_to_zero(
+            const SparseMatrix &amat, SolverWorkspace *workspace, double *avec, double *fvec, bool *c, bool *nc,
+            uint32_t n, uint32_t d
     );
 
-    /** Implementation of the algorithm described in Ref. 2.*/
-    void qp_solve(const double *amat, const double *bvec, double *fvec, uint32_t n);
+    /**
+     * Starts the algorithm of Ref. 2 from the initial guess in {fvec} instead of from zero. The contacts with a
+     * positive guess are clamped, and their forces are solved such that their accelerations are zero. Contacts of
+     * which the solved force is not positive are unclamped, until all are. Returns false if no contacts remain
+     * or if the accelerations cannot be brought to zero, in which case {avec}, {fvec} and {c} are unchanged. On
+     * entry {SolverWorkspace::factor} is empty, on return it factorizes A_CC. */
+    bool warm_start(
+            const SparseMatrix &amat, SolverWorkspace *workspace, const double *bvec, double *avec, double *fvec,
+            bool *c, uint32_t n);
+
+    /**
+     * Implementation of the algorithm described in Ref. 2. On entry {fvec} contains an initial guess, which is
+     * used if {warm_start} accepts it, an all-zero guess gives the original algorithm. Returns the number of
+     * pivots performed by {drive_to_zero}. {amat} must be symmetric. Only allocates if {workspace} has to grow.*/
+    uint32_t qp_solve(
+            const SparseMatrix &amat, const double *bvec, double *fvec, uint32_t n, SolverWorkspace *workspace);
+
+    /**
+     * Projected Gauss-Seidel: sweeps over the contacts, setting every force such that its acceleration is zero
+     * unless that requires pulling, in which case the force is zero. Starts from the guess in {fvec} and stops
+     * after {max_iterations} sweeps or once {lcp_residual} is at most {tolerance}, such that the cost is bounded
+     * but the result is approximate. Returns the number of sweeps.*/
+    uint32_t pgs_solve(
+            const SparseMatrix &amat, const double *bvec, double *fvec, uint32_t n, uint32_t max_iterations,
+            double tolerance, SolverWorkspace *workspace);
+
+    /**
+     * Largest violation of the conditions f >= 0, a >= 0 and f * a = 0 on a = A * f + b, measured as the largest
+     * |min(f_i, a_i)|. Zero for an exact solution. {avec} receives a. */
+    double lcp_residual(const SparseMatrix &amat, const double *bvec, const double *fvec, double *avec, uint32_t n);
 
     /** Solves for a symmetric, positive semi definite matrix. */
     void lp_solve(double *amat, double *xvec, double *bvec, uint32_t n);
@@ -42,6 +201,9 @@ namespace math {
     /** res = mat * vec */
     void mat_mul_vec(double *res, const double *mat, const double *vec, uint32_t n);
 
+    /** res = mat * vec */
+    void mat_mul_vec(double *res, const SparseMatrix &mat, const double *vec);
+
     /** r += v */
     void vec_add_equal(uint32_t n, double *r, const double *v);
 
@@ -0,0 +1,38 @@
+#include "monte_carlo.hpp"
+#include "engine.hpp"
+#include "outcome.hpp"
+#include "thread_pool.hpp"
+
+std::vector<Roll> MonteCarlo::roll(ThreadPool *pool, const std::function<Scene *(uint32_t)> &create_scene,
+                                   uint32_t first_seed, uint32_t count, uint32_t max_steps)
+{
+    std::vector<Roll> rolls(count);
+    pool->parallel_for(count, [&](uint32_t i, uint32_t) {
+        Roll &roll = rolls[i];
+        roll.seed = first_seed + i;
+
+        // the pool already keeps every thread busy, so the engine does not start threads of its own
+        Engine engine;
+        engine.threads = 1;
+        engine.sleeping = true;
+        engine.change_scene(create_scene(roll.seed));
+        engine.run = true;
+
+        roll.steps = 0;
+        roll.settled = false;
+        while (roll.steps < max_steps && !roll.settled) {
+            engine.update();
+            roll.steps++;
+            roll.settled = engine.is_settled();
+        }
+        roll.truncated_steps = (uint32_t) engine.truncated_steps;
+
+        for (auto &body : engine.body_system->bodies) {
+            if (body.shape->get_inv_mass() == 0.) continue;
+            roll.orientations.emplace_back(body.q);
+            roll.faces.emplace_back(Outcome::up_face(&body));
+        }
+    });
+
+    return rolls;
+}
@@ -0,0 +1,51 @@
+#ifndef SIMULATION_MONTE_CARLO_HPP
+#define SIMULATION_MONTE_CARLO_HPP
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include <glm/gtc/quaternion.hpp>
+
+class Scene;
+
+class ThreadPool;
+
+/** Outcome of one simulation of {MonteCarlo::roll}. */
+struct Roll {
+    /** Seed the scene was created with. */
+    uint32_t seed;
+
+    /** Orientation at the end of every movable body, in the order of {BodySystem::bodies}. */
+    std::vector<glm::dquat> orientations;
+
+    /** Index of the face lying on top of every movable body at the end, see {Outcome::up_face}. */
+    std::vector<uint32_t> faces;
+
+    /** Number of steps simulated. */
+    uint32_t steps;
+
+    /** Whether the bodies came to rest within the step budget, see {Engine::is_settled}. */
+    bool settled;
+
+    /**
+     * Number of steps of which the rest was dropped, see {Engine::truncated_steps}. The outcome of a roll with
+     * truncated steps may not be one the bodies would physically reach. */
+    uint32_t truncated_steps;
+};
+
+/**
+ * Many independent simulations of a scene, such as rolling dice many times to tally the outcomes. Every simulation
+ * has its own {Engine} and {BodySystem}, runs on a single thread, and is one iteration of
+ * {ThreadPool::parallel_for}, which hands out the next simulation to whichever thread is done first. A simulation
+ * ends as soon as its bodies have settled, see {Engine::is_settled}. */
+namespace MonteCarlo {
+    /**
+     * Simulates the scenes created by {create_scene} for the seeds in [{first_seed}, {first_seed} + {count}) on
+     * {pool}, each for at most {max_steps} steps. {create_scene} is called concurrently, so the scene must not draw
+     * from shared state such as {std::rand}, see {RollScene}. Returns the rolls in the order of their seeds. */
+    std::vector<Roll> roll(ThreadPool *pool, const std::function<Scene *(uint32_t)> &create_scene,
+                           uint32_t first_seed, uint32_t count, uint32_t max_steps);
+}
+
+#endif //SIMULATION_MONTE_CARLO_HPP
@@ -0,0 +1,12 @@
+#ifndef SIMULATION_NARROWPHASE_TYPE_HPP
+#define SIMULATION_NARROWPHASE_TYPE_HPP
+
+/** Algorithm with which {CollisionDetection} tests a pair of bodies reported by the broadphase. */
+enum NarrowphaseType {
+    /** Scan all planes formed by faces and pairs of edges, see {Collision::intersect}. */
+    SAT,
+    /** Distance query on the convex hulls, see {Gjk}. Only uses the scan to derive contacts. */
+    GJK
+};
+
+#endif //SIMULATION_NARROWPHASE_TYPE_HPP
@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+
+#include "outcome.hpp"
+#include "body_system.hpp"
+#include "sleeping.hpp"
+
+uint32_t Outcome::up_face(const RigidBody *body, glm::dvec3 up)
+{
+    uint32_t face_count = body->shape->get_faces().size();
+    assert(face_count > 0);
+
+    uint32_t best = 0;
+    double best_dot = -DBL_MAX;
+    for (uint32_t i = 0; i < face_count; i++) {
+        double dot = glm::dot(body->get_unit_normal(i), up);
+        if (dot > best_dot) {
+            best_dot = dot;
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+double Outcome::specific_kinetic_energy(const BodySystem *body_system)
+{
+    double largest = 0.;
+    for (auto &body : body_system->bodies) {
+        if (!Sleeping::is_active(&body)) continue;
+
+        double energy = .5 * (glm::dot(body.p, body.v) + glm::dot(body.l, body.omega));
+        largest = std::max(largest, energy * body.shape->get_inv_mass());
+    }
+
+    return largest;
+}
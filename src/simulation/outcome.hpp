@@ -0,0 +1,29 @@
+#ifndef SIMULATION_OUTCOME_HPP
+#define SIMULATION_OUTCOME_HPP
+
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+
+class RigidBody;
+
+class BodySystem;
+
+/**
+ * Reading the result of a roll: which face of a die points up, and whether the bodies have stopped moving. A face
+ * is identified by its index to {Shape::get_faces} of the shape of the die, so the same index means the same face
+ * for every die of that shape, whichever way it was thrown. */
+namespace Outcome {
+    /**
+     * Index of the face of {body} of which the outward normal is closest to {up}, which is the face lying on top
+     * for a die resting on a horizontal surface. */
+    uint32_t up_face(const RigidBody *body, glm::dvec3 up = glm::dvec3(0., 1., 0.));
+
+    /**
+     * Largest kinetic energy, linear and rotational, per unit of mass of any active body of {body_system}. Per
+     * body, a die which still moves is not averaged out by the dice at rest, and per unit of mass, it does not
+     * depend on the masses. Zero if no body is active. */
+    double specific_kinetic_energy(const BodySystem *body_system);
+}
+
+#endif //SIMULATION_OUTCOME_HPP
@@ -0,0 +1,82 @@
+#include <algorithm>
+
+#include "plane_kernel.hpp"
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+void PlaneKernel::VertexArrays::assign(const std::vector<glm::dvec3> &vertices)
+{
+    uint32_t size = (vertices.size() + WIDTH - 1) / WIDTH * WIDTH;
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    for (uint32_t i = 0; i < size; i++) {
+        const glm::dvec3 &v = vertices[std::min(i, (uint32_t) vertices.size() - 1)];
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+}
+
+int32_t PlaneKernel::which_side(
+        const VertexArrays &vertices, glm::dvec3 translation, glm::dvec3 p, glm::dvec3 n, double tolerance)
+{
+    bool positive = false;
+    bool negative = false;
+    const double *x = vertices.x.data();
+    const double *y = vertices.y.data();
+    const double *z = vertices.z.data();
+    uint32_t size = vertices.x.size();
+
+    // the distance is computed as n.x * dx + n.y * dy + n.z * dz, in the order glm::dot computes it. no fused
+    // multiply-add is used, as it would round differently
+#if defined(__AVX__)
+    __m256d tx = _mm256_set1_pd(translation.x);
+    __m256d ty = _mm256_set1_pd(translation.y);
+    __m256d tz = _mm256_set1_pd(translation.z);
+    __m256d px = _mm256_set1_pd(p.x), py = _mm256_set1_pd(p.y), pz = _mm256_set1_pd(p.z);
+    __m256d nx = _mm256_set1_pd(n.x), ny = _mm256_set1_pd(n.y), nz = _mm256_set1_pd(n.z);
+    __m256d upper = _mm256_set1_pd(tolerance), lower = _mm256_set1_pd(-tolerance);
+    for (uint32_t i = 0; i < size; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_add_pd(_mm256_loadu_pd(x + i), tx), px);
+        __m256d dy = _mm256_sub_pd(_mm256_add_pd(_mm256_loadu_pd(y + i), ty), py);
+        __m256d dz = _mm256_sub_pd(_mm256_add_pd(_mm256_loadu_pd(z + i), tz), pz);
+        __m256d t = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(nx, dx), _mm256_mul_pd(ny, dy)), _mm256_mul_pd(nz, dz));
+        positive |= _mm256_movemask_pd(_mm256_cmp_pd(t, upper, _CMP_GT_OQ)) != 0;
+        negative |= _mm256_movemask_pd(_mm256_cmp_pd(t, lower, _CMP_LT_OQ)) != 0;
+        if (positive && negative) return 0;
+    }
+#elif defined(__SSE2__)
+    __m128d tx = _mm_set1_pd(translation.x), ty = _mm_set1_pd(translation.y), tz = _mm_set1_pd(translation.z);
+    __m128d px = _mm_set1_pd(p.x), py = _mm_set1_pd(p.y), pz = _mm_set1_pd(p.z);
+    __m128d nx = _mm_set1_pd(n.x), ny = _mm_set1_pd(n.y), nz = _mm_set1_pd(n.z);
+    __m128d upper = _mm_set1_pd(tolerance), lower = _mm_set1_pd(-tolerance);
+    for (uint32_t i = 0; i < size; i += 2) {
+        __m128d dx = _mm_sub_pd(_mm_add_pd(_mm_loadu_pd(x + i), tx), px);
+        __m128d dy = _mm_sub_pd(_mm_add_pd(_mm_loadu_pd(y + i), ty), py);
+        __m128d dz = _mm_sub_pd(_mm_add_pd(_mm_loadu_pd(z + i), tz), pz);
+        __m128d t = _mm_add_pd(_mm_add_pd(_mm_mul_pd(nx, dx), _mm_mul_pd(ny, dy)), _mm_mul_pd(nz, dz));
+        positive |= _mm_movemask_pd(_mm_cmpgt_pd(t, upper)) != 0;
+        negative |= _mm_movemask_pd(_mm_cmplt_pd(t, lower)) != 0;
+        if (positive && negative) return 0;
+    }
+#else
+    for (uint32_t i = 0; i < size; i++) {
+        double dx = (x[i] + translation.x) - p.x;
+        double dy = (y[i] + translation.y) - p.y;
+        double dz = (z[i] + translation.z) - p.z;
+        double t = n.x * dx + n.y * dy + n.z * dz;
+        if (t > tolerance) positive = true; else if (t < -tolerance) negative = true;
+        if (positive && negative) return 0;
+    }
+#endif
+
+    if (positive) {
+        return +1;
+    } else {
+        return -1;
+    }
+}
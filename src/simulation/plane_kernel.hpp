@@ -0,0 +1,37 @@
+#ifndef SIMULATION_PLANE_KERNEL_HPP
+#define SIMULATION_PLANE_KERNEL_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+
+/**
+ * Classification of many vertices against a plane at once, using AVX if the compiler targets it, SSE2 otherwise
+ * and plain scalar code if neither is available. The signed distance of every vertex is rounded exactly as
+ * glm::dot(n, (v + translation) - p) is, such that the result does not depend on the instruction set. */
+namespace PlaneKernel {
+    /** Number of vertices processed at once by the widest kernel. */
+    const uint32_t WIDTH = 4;
+
+    /**
+     * Vertices with a separate array for every coordinate. The arrays are padded to a multiple of {WIDTH} by
+     * repeating the last vertex, which does not change the side the vertices lie on. */
+    struct VertexArrays {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> z;
+
+        /** Fills the arrays from {vertices}, reusing their capacity. */
+        void assign(const std::vector<glm::dvec3> &vertices);
+    };
+
+    /**
+     * Tests on which side the vertices translated by {translation} lie compared to the plane formed by {p} and
+     * {n}, where only vertices further than {tolerance} from the plane count. Returns 0 if vertices lie on both
+     * sides, +1 if some lie on the positive side only and -1 otherwise. */
+    int32_t which_side(
+            const VertexArrays &vertices, glm::dvec3 translation, glm::dvec3 p, glm::dvec3 n, double tolerance);
+}
+
+#endif //SIMULATION_PLANE_KERNEL_HPP
@@ -35,6 +35,21 @@ const std::vector<std::pair<uint32_t, uint32_t>> &ShapeWithMass::get_edges() con
     return body->get_edges();
 }
 
+const std::vector<std::pair<uint32_t, uint32_t>> &ShapeWithMass::get_edge_faces() const
+{
+    return body->get_edge_faces();
+}
+
+const std::vector<std::vector<uint32_t>> &ShapeWithMass::get_vertex_adjacency() const
+{
+    return body->get_vertex_adjacency();
+}
+
+uint32_t ShapeWithMass::find_edge(uint32_t v1, uint32_t v2) const
+{
+    return body->find_edge(v1, v2);
+}
+
 ShapeWithMass::ShapeWithMass(
         double inv_mass, double size_x, double size_y, double size_z
 ) :
@@ -70,14 +85,28 @@ Icosahedron::Icosahedron(
     body = &Shape::ICOSAHEDRON;
 }
 
+WorldSpaceCache::WorldSpaceCache(
+        const WorldSpaceCache &
+) :
+        valid(false)
+{}
+
+WorldSpaceCache &WorldSpaceCache::operator=(const WorldSpaceCache &)
+{
+    // keep the vectors, only invalidate
+    valid = false;
+    return *this;
+}
+
 RigidBody::RigidBody(
         glm::dvec3 p_x, ShapeWithMass const *p_shape_with_mass
 ) :
-        shape(p_shape_with_mass), x(p_x), p(glm::dvec3()), a(glm::identity<glm::dmat3>()), l(glm::dvec3()),
+        shape(p_shape_with_mass), x(p_x), p(glm::dvec3()), q(glm::dquat(1., 0., 0., 0.)), l(glm::dvec3()),
         force(glm::dvec3()), torque(glm::dvec3())
 {
     // compute initial auxiliary variables
     v = p * shape->get_inv_mass();
+    glm::dmat3 a = get_rotation();
     i_inv = a * shape->get_inv_moment_of_inertia() * glm::transpose(a);
     omega = i_inv * l;
 }
@@ -87,7 +116,7 @@ RigidBody::RigidBody(
 ) :
         RigidBody(p_x, p_shape_with_mass)
 {
-    this->a = p_a;
+    this->q = glm::normalize(glm::quat_cast(p_a));
 }
 
 RigidBody::RigidBody(
@@ -106,26 +135,96 @@ RigidBody::RigidBody(
     this->l = p_l;
 }
 
+void RigidBody::update_world_space() const
+{
+    if (world_space.valid && world_space.x == x && world_space.q == q) return;
+
+    // the rotation matrix is derived once for all vertices and normals
+    glm::dmat3 a = get_rotation();
+    const std::vector<glm::dvec3> &model_vertices = shape->get_model_vertices();
+    world_space.vertices.resize(model_vertices.size());
+    for (uint32_t i = 0; i < model_vertices.size(); i++) {
+        world_space.vertices[i] = a * (shape->get_scale() * model_vertices[i]) + x;
+    }
+    world_space.vertex_arrays.assign(world_space.vertices);
+
+    world_space.normals.resize(shape->get_faces().size());
+    for (uint32_t i = 0; i < world_space.normals.size(); i++) {
+        world_space.normals[i] = glm::normalize(a * shape->get_body()->get_non_unit_normal(i));
+    }
+
+    world_space.x = x;
+    world_space.q = q;
+    world_space.valid = true;
+}
+
+glm::dmat3 RigidBody::get_rotation() const
+{
+    return glm::mat3_cast(q);
+}
+
 glm::dvec3 RigidBody::get_non_unit_normal(uint32_t face_i) const
 {
     // apply rotation of the rigid body
-    return a * shape->get_body()->get_non_unit_normal(face_i);
+    return get_rotation() * shape->get_body()->get_non_unit_normal(face_i);
 }
 
 glm::dvec3 RigidBody::convert_to_world_space(glm::dvec3 point) const
 {
-    return a * (shape->get_scale() * point) + x;
+    return get_rotation() * (shape->get_scale() * point) + x;
+}
+
+const glm::dvec3 &RigidBody::get_unit_normal(uint32_t face_i) const
+{
+    update_world_space();
+    return world_space.normals[face_i];
 }
 
 glm::dvec3 RigidBody::get_world_space_vertex(uint32_t vertex_i) const
 {
-    return convert_to_world_space(shape->get_body()->get_vertices()[vertex_i]);
+    update_world_space();
+    return world_space.vertices[vertex_i];
+}
+
+const std::vector<glm::dvec3> &RigidBody::get_world_space_vertices() const
+{
+    update_world_space();
+    return world_space.vertices;
+}
+
+const PlaneKernel::VertexArrays &RigidBody::get_world_space_vertex_arrays() const
+{
+    update_world_space();
+    return world_space.vertex_arrays;
 }
 
 glm::dvec3 RigidBody::get_world_space_vertex(uint32_t vertex_i, double offset, glm::dvec3 dir) const
 {
-    glm::dvec3 point = shape->get_scale() * shape->get_body()->get_vertices()[vertex_i];
-    return a * point + x + offset * glm::normalize(dir);
+    return get_world_space_vertex(vertex_i) + offset * glm::normalize(dir);
+}
+
+uint32_t RigidBody::support(glm::dvec3 dir, uint32_t start) const
+{
+    const std::vector<glm::dvec3> &vertices = get_world_space_vertices();
+    const std::vector<std::vector<uint32_t>> &adjacency = shape->get_vertex_adjacency();
+
+    uint32_t best = start;
+    double best_t = glm::dot(dir, vertices[best]);
+    bool climbing = true;
+    while (climbing) {
+        climbing = false;
+        for (auto &neighbor : adjacency[best]) {
+            double t = glm::dot(dir, vertices[neighbor]);
+            if (t > best_t) {
+                best = neighbor;
+                best_t = t;
+                climbing = true;
+                break;
+            }
+        }
+    }
+
+    return best;
 }
 
 void RigidBody::clear_force_and_torque()
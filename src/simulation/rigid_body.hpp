@@ -8,8 +8,10 @@
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include "../shape/shape.hpp"
+#include "plane_kernel.hpp"
 
 class Contact;
 
@@ -37,6 +39,12 @@ public:
     const std::vector<glm::dvec3> &get_model_vertices() const;
 
     const std::vector<std::pair<uint32_t, uint32_t>> &get_edges() const;
+
+    const std::vector<std::pair<uint32_t, uint32_t>> &get_edge_faces() const;
+
+    const std::vector<std::vector<uint32_t>> &get_vertex_adjacency() const;
+
+    uint32_t find_edge(uint32_t v1, uint32_t v2) const;
 };
 
 /** Creates a box with appropriate moment of inertia. */
@@ -51,7 +59,37 @@ public:
     Icosahedron(double inv_mass, double size_x, double size_y, double size_z);
 };
 
+/**
+ * World space vertices and unit face normals of a {RigidBody}, for the position and orientation in {x} and {q}.
+ * A copy is invalid and does not copy the contents, such that saving and restoring the state of the bodies
+ * is not slowed down, and the capacity of the vectors is reused when assigning. */
+class WorldSpaceCache {
+public:
+    bool valid = false;
+    glm::dvec3 x{};
+    glm::dquat q{};
+
+    std::vector<glm::dvec3> vertices;
+    std::vector<glm::dvec3> normals;
+    /** {vertices}, laid out for {PlaneKernel}. */
+    PlaneKernel::VertexArrays vertex_arrays;
+
+    WorldSpaceCache() = default;
+
+    WorldSpaceCache(const WorldSpaceCache &other);
+
+    WorldSpaceCache &operator=(const WorldSpaceCache &other);
+};
+
 class RigidBody {
+private:
+    /**
+     * Lazily computed, since {x} and {q} are written directly, it is validated on every access by comparing
+     * them to the position and orientation it was computed for. */
+    mutable WorldSpaceCache world_space;
+
+    /** Recompute {world_space} if {x} or {q} have changed. */
+    void update_world_space() const;
 public:
     /** Constant quantities. */
     // explicitly not destructed, should be done manually
@@ -62,7 +100,7 @@ public:
     glm::dvec3 x;      // position
     glm::dvec3 p;      // linear momentum
 
-    glm::dmat3 a;      // rotation matrix
+    glm::dquat q;      // orientation, a unit quaternion
     glm::dvec3 l;      // angular momentum
 
     /** Auxiliary quantities. */
@@ -74,6 +112,16 @@ public:
     glm::dvec3 force;  // force
     glm::dvec3 torque; // torque
 
+    /** Sleeping, see {Sleeping}. */
+    bool asleep = false;       // not moved by the simulation
+    double rest_time = 0.;     // time the body has been moving slower than the sleep thresholds
+    uint32_t sleep_group = 0;  // bodies which fell asleep together share the group
+
+    /**
+     * Whether the body has been integrated to the end of the current step while others search their time of
+     * collision, see {Engine::localized_substeps}. Such a body is not integrated again in this step. */
+    bool finished = false;
+
     RigidBody(glm::dvec3 p_x, ShapeWithMass const *p_shape_with_mass);
 
     RigidBody(glm::dvec3 p_x, glm::dmat3 p_a, ShapeWithMass const *p_shape_with_mass);
@@ -82,18 +130,36 @@ public:
 
     RigidBody(glm::dvec3 p_x, glm::dmat3 p_a, glm::dvec3 p_p, glm::dvec3 p_l, ShapeWithMass const *p_shape_with_mass);
 
+    /** Get the rotation matrix of {q}, computed on every call. */
+    glm::dmat3 get_rotation() const;
+
     /** Get the non-unitized normal of face {face_i}. */
     glm::dvec3 get_non_unit_normal(uint32_t face_i) const;
 
+    /** Get the unit normal of face {face_i}, pointing outwards. */
+    const glm::dvec3 &get_unit_normal(uint32_t face_i) const;
+
     /** Get world space vertex from point. */
     glm::dvec3 convert_to_world_space(glm::dvec3 point) const;
 
     /** Get world space vertex from index. */
     glm::dvec3 get_world_space_vertex(uint32_t vertex_i) const;
 
+    /** Get all world space vertices, in the order of the model vertices. */
+    const std::vector<glm::dvec3> &get_world_space_vertices() const;
+
+    /** Get all world space vertices, laid out for {PlaneKernel}. */
+    const PlaneKernel::VertexArrays &get_world_space_vertex_arrays() const;
+
     /** Get world space vertex from index, with an offset of {offset} units. */
     glm::dvec3 get_world_space_vertex(uint32_t vertex_i, double offset, glm::dvec3 dir) const;
 
+    /**
+     * Get the index of the vertex furthest along {dir}. As the shape is convex, any vertex which lies no further
+     * along {dir} than its neighbors is furthest, so the vertex adjacency is walked from {start} until none of the
+     * neighbors lie further. */
+    uint32_t support(glm::dvec3 dir, uint32_t start = 0) const;
+
     void clear_force_and_torque();
 
     /** Return the velocity of a point on a rigid body. */
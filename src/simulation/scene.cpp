@@ -1,3 +1,5 @@
+#include <random>
+
 #include "scene.hpp"
 
 Scene::~Scene()
@@ -404,3 +406,146 @@ BodySystem *ContactScene::initialize()
 
     return bs;
 }
+
+DiceGridScene::DiceGridScene(
+        uint32_t p_count_x, uint32_t p_count_z, uint32_t p_layers
+) :
+        count_x(p_count_x), count_z(p_count_z), layers(p_layers)
+{}
+
+BodySystem *DiceGridScene::initialize()
+{
+    auto bs = new BodySystem();
+
+    // the diagonal of a cube is smaller than the spacing, so no pair can touch regardless of orientation
+    const double SIZE = 1.;
+    const double SPACING = 2. * SIZE;
+
+    // create an immovable surface which spans the grid
+    const double HEIGHT = .4;
+    const ShapeWithMass *surface = new Box(
+            0., (double) count_x * SPACING + SPACING, HEIGHT, (double) count_z * SPACING + SPACING);
+    shapes.emplace_back(surface);
+    bs->bodies.emplace_back(glm::dvec3(0., -HEIGHT / 2., 0.), surface);
+
+    const double MASS = 3.;
+    const ShapeWithMass *cube = new Box(1. / MASS, SIZE, SIZE, SIZE);
+    shapes.emplace_back(cube);
+    for (uint32_t i = 0; i < layers; i++) {
+        for (uint32_t j = 0; j < count_x; j++) {
+            for (uint32_t k = 0; k < count_z; k++) {
+                bs->bodies.emplace_back(
+                        glm::dvec3(
+                                ((double) j - .5 * (double) (count_x - 1)) * SPACING,
+                                SPACING + (double) i * SPACING,
+                                ((double) k - .5 * (double) (count_z - 1)) * SPACING),
+                        glm::dmat3(glm::rotate(
+                                glm::identity<glm::dmat4>(),
+                                (double) std::rand() * (double) M_PI_2 * 2. / (double) RAND_MAX,
+                                glm::normalize(glm::dvec3(
+                                        (double) std::rand() / (double) RAND_MAX - .5,
+                                        (double) std::rand() / (double) RAND_MAX - .5,
+                                        (double) std::rand() / (double) RAND_MAX + .5)))),
+                        cube
+                );
+            }
+        }
+    }
+
+    // apply gravity
+    bs->forces.emplace_back(new GravityForce(bs));
+
+    return bs;
+}
+
+PilesScene::PilesScene(
+        uint32_t p_count_x, uint32_t p_count_z, uint32_t p_pile_size
+) :
+        count_x(p_count_x), count_z(p_count_z), pile_size(p_pile_size)
+{}
+
+BodySystem *PilesScene::initialize()
+{
+    auto bs = new BodySystem();
+
+    // one cube of space between the piles
+    const double SIZE = 1.;
+    const double SPACING = (double) (pile_size + 1) * SIZE;
+
+    // create an immovable surface which spans the piles
+    const double HEIGHT = .4;
+    const ShapeWithMass *surface = new Box(
+            0., (double) count_x * SPACING + SPACING, HEIGHT, (double) count_z * SPACING + SPACING);
+    shapes.emplace_back(surface);
+    bs->bodies.emplace_back(glm::dvec3(0., -HEIGHT / 2., 0.), surface);
+
+    const double MASS = 3.;
+    const ShapeWithMass *cube = new Box(1. / MASS, SIZE, SIZE, SIZE);
+    shapes.emplace_back(cube);
+    for (uint32_t i = 0; i < count_x; i++) {
+        for (uint32_t j = 0; j < count_z; j++) {
+            glm::dvec3 center(
+                    ((double) i - .5 * (double) (count_x - 1)) * SPACING, SIZE / 2.,
+                    ((double) j - .5 * (double) (count_z - 1)) * SPACING);
+            for (uint32_t k = 0; k < pile_size; k++) {
+                for (uint32_t l = 0; l < pile_size; l++) {
+                    bs->bodies.emplace_back(center + SIZE * glm::dvec3(
+                            (double) k - .5 * (double) (pile_size - 1), 0.,
+                            (double) l - .5 * (double) (pile_size - 1)), cube);
+                }
+            }
+        }
+    }
+
+    // apply gravity
+    bs->forces.emplace_back(new GravityForce(bs));
+
+    return bs;
+}
+
+RollScene::RollScene(
+        uint32_t p_dice, uint32_t p_seed
+) :
+        dice(p_dice), seed(p_seed)
+{}
+
+BodySystem *RollScene::initialize()
+{
+    auto bs = new BodySystem();
+
+    // create an immovable surface
+    const double HEIGHT = .4;
+    const ShapeWithMass *surface = new Box(0., 16., HEIGHT, 10.);
+    shapes.emplace_back(surface);
+    bs->bodies.emplace_back(glm::dvec3(0., -HEIGHT / 2., 0.), surface);
+
+    const double MASS = 3.;
+    const double SIZE = 1.;
+    const ShapeWithMass *cube = new Box(1. / MASS, SIZE, SIZE, SIZE);
+    shapes.emplace_back(cube);
+
+    // the dice are released side by side, far enough apart that no pair touches regardless of orientation, and
+    // slow enough to land on the surface
+    const double SPACING = 2. * SIZE;
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> unit(-1., 1.);
+    for (uint32_t i = 0; i < dice; i++) {
+        glm::dvec3 axis(unit(generator), unit(generator), unit(generator));
+        if (glm::length(axis) == 0.) axis = glm::dvec3(0., 1., 0.);
+        bs->bodies.emplace_back(
+                glm::dvec3(((double) i - .5 * (double) (dice - 1)) * SPACING, 3. + .5 * unit(generator), 0.),
+                glm::dmat3(glm::rotate(
+                        glm::identity<glm::dmat4>(), (double) M_PI * unit(generator), glm::normalize(axis))),
+                MASS * glm::dvec3(.5 * unit(generator), unit(generator), .5 * unit(generator)),
+                MASS * glm::dvec3(1.5 * unit(generator), 1.5 * unit(generator), 1.5 * unit(generator)),
+                cube);
+    }
+
+    // apply gravity
+    bs->forces.emplace_back(new GravityForce(bs));
+
+    // apply air resistance, as contacts have no friction, nothing else stops the dice from sliding and spinning
+    bs->forces.emplace_back(new DragForce(bs));
+
+    return bs;
+}
@@ -73,4 +73,47 @@ public:
     BodySystem *initialize() override;
 };
 
+/**
+ * Randomly oriented cubes on a {count_x} by {count_z} grid, repeated in {layers} layers, above an immovable
+ * surface. The cubes are spaced such that no pair touches initially. Used for measuring performance. */
+class DiceGridScene : public Scene {
+private:
+    uint32_t count_x;
+    uint32_t count_z;
+    uint32_t layers;
+public:
+    DiceGridScene(uint32_t p_count_x, uint32_t p_count_z, uint32_t p_layers);
+
+    BodySystem *initialize() override;
+};
+
+/**
+ * Resting cubes in {count_x} by {count_z} piles on an immovable surface. Every pile is a {pile_size} by
+ * {pile_size} block of touching cubes, and the piles are spaced such that no pair of piles touches. Used for
+ * measuring the performance of the contact force solver, as every pile forms a separate island. */
+class PilesScene : public Scene {
+private:
+    uint32_t count_x;
+    uint32_t count_z;
+    uint32_t pile_size;
+public:
+    PilesScene(uint32_t p_count_x, uint32_t p_count_z, uint32_t p_pile_size);
+
+    BodySystem *initialize() override;
+};
+
+/**
+ * {dice} cubes thrown onto an immovable surface, with an orientation, linear and angular velocity drawn from a
+ * random generator seeded with {seed}, such that every seed is another roll. Unlike the other scenes, it does not
+ * draw from {std::rand}, so scenes of different seeds can be initialized concurrently. Used by {MonteCarlo}. */
+class RollScene : public Scene {
+private:
+    uint32_t dice;
+    uint32_t seed;
+public:
+    RollScene(uint32_t p_dice, uint32_t p_seed);
+
+    BodySystem *initialize() override;
+};
+
 #endif //SIMULATION_SCENE_HPP
@@ -0,0 +1,67 @@
+#include "separating_feature_cache.hpp"
+
+uint64_t SeparatingFeatureCache::get_key(uint32_t i, uint32_t j)
+{
+    return (uint64_t) i << 32u | j;
+}
+
+Collision::IntersectResult SeparatingFeatureCache::intersect(
+        RigidBody *x, RigidBody *y, uint32_t i, uint32_t j, double offset)
+{
+    if (!enabled) return Collision::intersect(x, y, offset);
+
+    uint64_t key = get_key(i, j);
+    auto it = features.find(key);
+    const Collision::SeparatingFeature *feature = it != features.end() ? &it->second : nullptr;
+    Collision::IntersectResult result;
+
+    // contact derivation relies on the order in which {Collision::intersect} prefers planes: faces of x, then
+    // faces of y, then pairs of edges. the cached feature is tested as soon as no preferred plane can exist,
+    // as the faces are cheap to test compared to all pairs of edges
+    if (feature && !feature->ee && feature->on_x && Collision::test_feature(x, y, *feature, offset, &result)) {
+        hits++;
+        return result;
+    }
+
+    bool found = Collision::intersect_faces(y, x, offset, &result);
+    if (!found && feature && !feature->ee && !feature->on_x &&
+        Collision::test_feature(x, y, *feature, offset, &result)) {
+        hits++;
+        return result;
+    }
+
+    if (!found) found = Collision::intersect_faces(x, y, offset, &result);
+    if (!found && feature && feature->ee && Collision::test_feature(x, y, *feature, offset, &result)) {
+        hits++;
+        return result;
+    }
+
+    misses++;
+    if (!found) found = Collision::intersect_edges(x, y, offset, &result);
+    if (found) {
+        features[key] = Collision::SeparatingFeature(result, x);
+    }
+
+    return result;
+}
+
+void SeparatingFeatureCache::clear()
+{
+    features.clear();
+}
+
+uint64_t SeparatingFeatureCache::get_hits() const
+{
+    return hits;
+}
+
+uint64_t SeparatingFeatureCache::get_misses() const
+{
+    return misses;
+}
+
+void SeparatingFeatureCache::reset_counts()
+{
+    hits = 0;
+    misses = 0;
+}
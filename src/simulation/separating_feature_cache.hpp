@@ -0,0 +1,45 @@
+#ifndef SIMULATION_SEPARATING_FEATURE_CACHE_HPP
+#define SIMULATION_SEPARATING_FEATURE_CACHE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "collision.hpp"
+
+/**
+ * Remembers per pair of bodies the feature that formed the last separating plane. Between iterations of the
+ * bisection and between steps, bodies move little and the same plane almost always still separates them, so
+ * it is tested first before falling back to the full scan of {Collision::intersect}. */
+class SeparatingFeatureCache {
+private:
+    /** Last separating feature of every pair, by {get_key}. */
+    std::unordered_map<uint64_t, Collision::SeparatingFeature> features;
+
+    /** Number of calls to {intersect} for which the cached feature separated the pair. */
+    uint64_t hits = 0;
+
+    /** Number of calls to {intersect} that required the full scan. */
+    uint64_t misses = 0;
+
+    static uint64_t get_key(uint32_t i, uint32_t j);
+public:
+    /** If false, every call to {intersect} performs the full scan. */
+    bool enabled = true;
+
+    /**
+     * Equivalent to {Collision::intersect}, where {i} and {j} are the indices of {x} and {y} in
+     * {BodySystem::bodies}. */
+    Collision::IntersectResult intersect(RigidBody *x, RigidBody *y, uint32_t i, uint32_t j, double offset);
+
+    /** Forget all pairs, for instance when the bodies are replaced. */
+    void clear();
+
+    uint64_t get_hits() const;
+
+    uint64_t get_misses() const;
+
+    /** Reset the hit and miss counts. */
+    void reset_counts();
+};
+
+#endif //SIMULATION_SEPARATING_FEATURE_CACHE_HPP
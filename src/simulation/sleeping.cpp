@@ -0,0 +1,91 @@
+#include "sleeping.hpp"
+#include "body_system.hpp"
+#include "contact.hpp"
+
+bool Sleeping::is_active(const RigidBody *body)
+{
+    return !body->asleep && body->shape->get_inv_mass() != 0.;
+}
+
+void Sleeping::wake(BodySystem *body_system, uint32_t i)
+{
+    if (!body_system->bodies[i].asleep) return;
+
+    uint32_t group = body_system->bodies[i].sleep_group;
+    for (auto &body : body_system->bodies) {
+        if (!body.asleep || body.sleep_group != group) continue;
+
+        body.asleep = false;
+        body.rest_time = 0.;
+    }
+}
+
+void Sleeping::wake_pushed(BodySystem *body_system)
+{
+    // the momenta are zeroed when falling asleep
+    for (uint32_t i = 0; i < body_system->bodies.size(); i++) {
+        const RigidBody &body = body_system->bodies[i];
+        if (!body.asleep) continue;
+        if (body.p != glm::dvec3(0.) || body.l != glm::dvec3(0.)) wake(body_system, i);
+    }
+}
+
+bool Sleeping::wake_touched(BodySystem *body_system, const std::vector<Contact *> &contacts)
+{
+    bool woke = false;
+    for (auto &contact : contacts) {
+        RigidBody *a = contact->body_a;
+        RigidBody *b = contact->body_b;
+        if (a->asleep && is_active(b)) {
+            wake(body_system, a - body_system->bodies.data());
+            woke = true;
+        } else if (b->asleep && is_active(a)) {
+            wake(body_system, b - body_system->bodies.data());
+            woke = true;
+        }
+    }
+
+    return woke;
+}
+
+void Sleeping::update(BodySystem *body_system, const std::vector<Contact *> &contacts, double dt)
+{
+    if (!body_system->use_sleeping) return;
+
+    std::vector<RigidBody> &bodies = body_system->bodies;
+    for (auto &body : bodies) {
+        if (!is_active(&body)) continue;
+
+        bool resting = glm::length(body.v) < body_system->sleep_linear_velocity &&
+                       glm::length(body.omega) < body_system->sleep_angular_velocity;
+        body.rest_time = resting ? body.rest_time + dt : 0.;
+    }
+
+    // groups of active bodies connected through contacts, as in {Island::find_islands}
+    UnionFind groups(bodies.size());
+    for (auto &contact : contacts) {
+        if (!is_active(contact->body_a) || !is_active(contact->body_b)) continue;
+        groups.unite(contact->body_a - bodies.data(), contact->body_b - bodies.data());
+    }
+
+    // a group sleeps if all of its bodies have rested long enough
+    std::vector<bool> restless(bodies.size(), false);
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        if (!is_active(&bodies[i])) continue;
+        if (bodies[i].rest_time < body_system->sleep_time) restless[groups.find(i)] = true;
+    }
+
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        if (!is_active(&bodies[i]) || restless[groups.find(i)]) continue;
+
+        RigidBody &body = bodies[i];
+        body.asleep = true;
+        body.sleep_group = groups.find(i);
+
+        // remove the remaining drift, such that the body wakes at rest
+        body.p = glm::dvec3(0.);
+        body.l = glm::dvec3(0.);
+        body.v = glm::dvec3(0.);
+        body.omega = glm::dvec3(0.);
+    }
+}
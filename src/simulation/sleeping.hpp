@@ -0,0 +1,41 @@
+#ifndef SIMULATION_SLEEPING_HPP
+#define SIMULATION_SLEEPING_HPP
+
+#include <vector>
+#include <cstdint>
+
+class RigidBody;
+
+class Contact;
+
+class BodySystem;
+
+/**
+ * Deactivation of bodies at rest. Groups of movable bodies connected through contacts are put to sleep together
+ * once all of them have been moving slower than {BodySystem::sleep_linear_velocity} and
+ * {BodySystem::sleep_angular_velocity} for {BodySystem::sleep_time}. Sleeping bodies are not integrated, and pairs
+ * of bodies of which neither is active are not tested by {CollisionDetection}, so no contacts are solved for them.
+ * A group wakes as a whole when an active body touches one of its bodies, when one of its bodies is given momentum,
+ * or through {wake}. */
+namespace Sleeping {
+    /** Whether {body} is moved by the simulation, which is if it is movable and awake. */
+    bool is_active(const RigidBody *body);
+
+    /** Wakes body {i} of {body_system} and the bodies which fell asleep with it. */
+    void wake(BodySystem *body_system, uint32_t i);
+
+    /**
+     * Wakes the sleeping bodies which were given momentum since they fell asleep, which is how an impulse is applied
+     * from outside of {BodySystem::forces}. The forces only reach active bodies through {BodySystem::body_state}. */
+    void wake_pushed(BodySystem *body_system);
+
+    /** Wakes the sleeping bodies which are touched by an active body in {contacts}, returns whether any woke. */
+    bool wake_touched(BodySystem *body_system, const std::vector<Contact *> &contacts);
+
+    /**
+     * Advances the rest time of the active bodies by {dt} and puts the groups connected through {contacts} to sleep
+     * if all of their bodies have rested long enough. Does nothing unless {BodySystem::use_sleeping}. */
+    void update(BodySystem *body_system, const std::vector<Contact *> &contacts, double dt);
+}
+
+#endif //SIMULATION_SLEEPING_HPP
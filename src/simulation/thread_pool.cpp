@@ -0,0 +1,88 @@
+#include <algorithm>
+
+#include "thread_pool.hpp"
+
+ThreadPool::ThreadPool(
+        uint32_t thread_count
+) :
+        next(0)
+{
+    if (thread_count == 0) thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (uint32_t i = 1; i < thread_count; i++) {
+        workers.emplace_back(&ThreadPool::worker_main, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    start.notify_all();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+uint32_t ThreadPool::get_thread_count() const
+{
+    return workers.size() + 1;
+}
+
+void ThreadPool::work(uint32_t thread)
+{
+    for (uint32_t i = next++; i < count; i = next++) {
+        (*task)(i, thread);
+    }
+}
+
+void ThreadPool::worker_main(uint32_t thread)
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        work(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+        }
+        finish.notify_one();
+    }
+}
+
+void ThreadPool::parallel_for(uint32_t p_count, const std::function<void(uint32_t, uint32_t)> &p_task)
+{
+    if (workers.empty() || p_count <= 1) {
+        for (uint32_t i = 0; i < p_count; i++) {
+            p_task(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &p_task;
+        count = p_count;
+        next = 0;
+        busy = workers.size();
+        generation++;
+    }
+    start.notify_all();
+
+    work(0);
+
+    // the loop is done once every worker has stopped taking iterations
+    std::unique_lock<std::mutex> lock(mutex);
+    finish.wait(lock, [&] { return busy == 0; });
+    task = nullptr;
+}
@@ -0,0 +1,67 @@
+#ifndef SIMULATION_THREAD_POOL_HPP
+#define SIMULATION_THREAD_POOL_HPP
+
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+/**
+ * Fixed set of worker threads which run the iterations of a loop concurrently. The calling thread takes part in
+ * every loop, such that a pool of one thread has no workers and runs the loop in order. */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+
+    /** Signals the workers that {generation} changed or {stopping} is set. */
+    std::condition_variable start;
+
+    /** Signals the calling thread that a worker finished its part of the loop. */
+    std::condition_variable finish;
+
+    /** Incremented for every loop, such that workers can tell a new loop from a spurious wake up. */
+    uint64_t generation = 0;
+
+    bool stopping = false;
+
+    /** Number of workers still working on the current loop. */
+    uint32_t busy = 0;
+
+    /** Loop body and iteration count of the current loop. */
+    const std::function<void(uint32_t, uint32_t)> *task = nullptr;
+    uint32_t count = 0;
+
+    /** Next iteration of the current loop to hand out. */
+    std::atomic<uint32_t> next;
+
+    /** Runs iterations of the current loop on thread {thread} until none are left. */
+    void work(uint32_t thread);
+
+    void worker_main(uint32_t thread);
+public:
+    /** Creates a pool of {thread_count} threads, including the calling thread. If zero, the number of hardware
+     *  threads is used. */
+    explicit ThreadPool(uint32_t thread_count = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /** Number of threads, including the calling thread. */
+    uint32_t get_thread_count() const;
+
+    /**
+     * Calls {p_task} for every integer in [0, {p_count}) and returns once all calls finished. Calls may run in
+     * any order and concurrently, so they must not write shared state. The second argument is the index of the
+     * thread making the call, in [0, {get_thread_count}), where the calling thread is 0. */
+    void parallel_for(uint32_t p_count, const std::function<void(uint32_t, uint32_t)> &p_task);
+};
+
+#endif //SIMULATION_THREAD_POOL_HPP
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cmath>
+
+#include "time_of_impact.hpp"
+#include "engine.hpp"
+#include "gjk.hpp"
+
+/** Maximum number of advancements and of bisections of a pair. */
+const uint32_t MAX_ITERATIONS = 32;
+
+/** Distance, relative to {Engine::DISTANCE_THRESHOLD}, at which a pair is close enough to stop advancing. */
+const double TOLERANCE = .1;
+
+/**
+ * Depth, relative to {Engine::DISTANCE_THRESHOLD}, up to which a pair is in contact for the search. Less than the
+ * depth at which {CollisionDetection} finds interpenetration, such that no pair is left at the edge of
+ * interpenetrating, from which the next step cannot advance. */
+const double DEPTH = .5;
+
+/** Interval, relative to the remainder of the step, to which the time of contact of a pair is refined. */
+const double REFINEMENT = .125;
+
+/** Motion of a body over the step, from {x_0} and {q_0} to {x_1} and {q_1}. */
+struct Motion {
+    glm::dvec3 x_0;
+    glm::dvec3 x_1;
+    glm::dquat q_0;
+    glm::dquat q_1;
+    /** Angle rotated over the step. */
+    double angle;
+    /** Largest distance of a vertex to the center of mass. */
+    double radius;
+};
+
+/** Motion of body {i}, of which {slot} is the index in {BodySystem::body_state} or -1 if it is not integrated. */
+Motion get_motion(BodySystem *body_system, uint32_t i, int32_t slot)
+{
+    const RigidBody &body = body_system->bodies[i];
+    Motion motion;
+    motion.x_1 = body.x;
+    motion.q_1 = body.q;
+    motion.x_0 = slot < 0 ? body.x : body_system->body_state.x_0[slot];
+    motion.q_0 = slot < 0 ? body.q : body_system->body_state.q_0[slot];
+    motion.angle = 2. * std::acos(std::min(1., std::abs(glm::dot(motion.q_0, motion.q_1))));
+
+    motion.radius = 0.;
+    for (auto &vertex : body.shape->get_model_vertices()) {
+        motion.radius = std::max(motion.radius, glm::length(body.shape->get_scale() * vertex));
+    }
+
+    return motion;
+}
+
+/** Places {body} at fraction {s} of {motion}. */
+void set_pose(RigidBody *body, const Motion &motion, double s)
+{
+    body->x = motion.x_0 + s * (motion.x_1 - motion.x_0);
+    body->q = glm::slerp(motion.q_0, motion.q_1, s);
+}
+
+/** Smallest distance of the segment from {a} to {b} to the origin. */
+double segment_distance(glm::dvec3 a, glm::dvec3 b)
+{
+    glm::dvec3 ab = b - a;
+    double ab_ab = glm::dot(ab, ab);
+    if (ab_ab == 0.) return glm::length(a);
+
+    double t = std::min(1., std::max(0., -glm::dot(a, ab) / ab_ab));
+    return glm::length(a + t * ab);
+}
+
+/**
+ * State of the pair {x} and {y} at fraction {s} of their motions, as {CollisionDetection} classifies it, except
+ * that the pair is considered to interpenetrate from {depth} onward. */
+CollisionState classify(RigidBody *x, RigidBody *y, const Motion &motion_x, const Motion &motion_y, double s,
+                        double depth)
+{
+    set_pose(x, motion_x, s);
+    set_pose(y, motion_y, s);
+    if (Gjk::overlap(x, y, -depth)) return PENETRATING;
+    if (!Gjk::overlap(x, y, +Engine::DISTANCE_THRESHOLD)) return NOT_PENETRATING;
+
+    return CONTACT_RESTING_OR_COLLIDING;
+}
+
+/**
+ * Advances copies {x} and {y} of the pair along {motion_x} and {motion_y}. Returns the fraction of the step before
+ * {s_max} at which they are in contact, {s_max} if they do not interpenetrate before, or a negative value if they
+ * interpenetrate at the start or no such fraction is found. */
+double advance(RigidBody *x, RigidBody *y, const Motion &motion_x, const Motion &motion_y, double s_max)
+{
+    if (classify(x, y, motion_x, motion_y, 0., Engine::DISTANCE_THRESHOLD) == PENETRATING) return -1.;
+    // a pair which already is deeper than {DEPTH} may go as deep as {CollisionDetection} allows
+    double depth = DEPTH * Engine::DISTANCE_THRESHOLD;
+    if (classify(x, y, motion_x, motion_y, 0., depth) == PENETRATING) depth = Engine::DISTANCE_THRESHOLD;
+    // no earlier time is searched if the pair does not interpenetrate at {s_max}
+    if (classify(x, y, motion_x, motion_y, s_max, depth) != PENETRATING) return s_max;
+
+    // the distance of the bodies translated towards each other, as done to test for contact, shrinks at most by
+    // the relative motion of any two points, including the translation, which turns with the line between the
+    // centers
+    glm::dvec3 c_0 = motion_x.x_0 - motion_y.x_0;
+    glm::dvec3 c_1 = motion_x.x_1 - motion_y.x_1;
+    double linear = glm::length(c_1 - c_0);
+    double center_distance = segment_distance(c_0, c_1);
+    if (center_distance == 0.) return -1.;
+    double rate = linear + motion_x.angle * motion_x.radius + motion_y.angle * motion_y.radius +
+                  Engine::DISTANCE_THRESHOLD * linear / center_distance;
+
+    // advance while the pair is certainly not in contact, bodies in resting contact are not advanced
+    double s = 0.;
+    for (uint32_t i = 0; i < MAX_ITERATIONS; i++) {
+        set_pose(x, motion_x, s);
+        set_pose(y, motion_y, s);
+        Gjk::DistanceResult result = Gjk::distance(x, y, +Engine::DISTANCE_THRESHOLD);
+        // an unconverged distance may be too large to advance by
+        if (result.intersect || !result.converged) break;
+
+        double d = glm::length(result.v);
+        if (d <= TOLERANCE * Engine::DISTANCE_THRESHOLD) break;
+        s += d / rate;
+        if (s >= s_max) return s_max;
+    }
+
+    // the pair is about to be in contact at {s} and interpenetrates at {s_max}, bisect the remainder. Once in
+    // contact, the time is refined towards interpenetration, as every earlier time means another step
+    double lo = s;
+    double hi = s_max;
+    bool contact = false;
+    for (uint32_t i = 0; i < MAX_ITERATIONS; i++) {
+        if (contact && hi - lo <= REFINEMENT * (s_max - s)) break;
+
+        double mid = .5 * (lo + hi);
+        CollisionState state = classify(x, y, motion_x, motion_y, mid, depth);
+        if (state == PENETRATING) {
+            hi = mid;
+        } else {
+            lo = mid;
+            contact = state != NOT_PENETRATING;
+        }
+    }
+
+    return contact ? lo : -1.;
+}
+
+double TimeOfImpact::find(BodySystem *body_system, const std::vector<std::pair<uint32_t, uint32_t>> &pairs, double dt)
+{
+    const std::vector<int32_t> &slots = body_system->body_state.slot;
+    double s_min = 1.;
+    for (auto &pair : pairs) {
+        RigidBody x = body_system->bodies[pair.first];
+        RigidBody y = body_system->bodies[pair.second];
+        s_min = advance(&x, &y, get_motion(body_system, pair.first, slots[pair.first]),
+                        get_motion(body_system, pair.second, slots[pair.second]), s_min);
+        if (s_min < 0.) return 0.;
+    }
+
+    return s_min * dt;
+}
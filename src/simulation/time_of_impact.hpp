@@ -0,0 +1,24 @@
+#ifndef SIMULATION_TIME_OF_IMPACT_HPP
+#define SIMULATION_TIME_OF_IMPACT_HPP
+
+#include <vector>
+#include <cstdint>
+
+class BodySystem;
+
+/**
+ * Time of impact by conservative advancement. Over a step, every body is assumed to move with constant linear and
+ * angular velocity from its state at the start of the last {Integrator::runge_kutta_4}, kept in
+ * {BodySystem::body_state}, to its current state. With a bound on how fast the distance between two bodies can
+ * shrink, a pair is advanced by the time it certainly needs to close its current distance, until it is nearly in
+ * contact. The remainder of the step is bisected for the pair alone. Only the two bodies of a pair are moved, the
+ * bodies in {BodySystem::bodies} are not changed. */
+namespace TimeOfImpact {
+    /**
+     * Returns a time in (0, {dt}] at which one of {pairs} of body indices is in contact, within
+     * {Engine::DISTANCE_THRESHOLD}, before any of them interpenetrates. Returns 0 if a pair interpenetrates at the
+     * start or no time is found for a pair. */
+    double find(BodySystem *body_system, const std::vector<std::pair<uint32_t, uint32_t>> &pairs, double dt);
+}
+
+#endif //SIMULATION_TIME_OF_IMPACT_HPP
@@ -47,7 +47,7 @@ void Renderer::render(Engine *engine)
 
         glm::mat4 model_matrix =
                 glm::translate(glm::identity<glm::dmat4>(), body.x) *
-                glm::dmat4(body.a) *
+                glm::mat4_cast(body.q) *
                 glm::dmat4(body.shape->get_scale());
 
         ShaderProgram::set_mat4(program, "modelMatrix", model_matrix);
@@ -84,7 +84,7 @@ void Renderer::render(Engine *engine)
         Texture::bind_tex(texture_manager->get(TEXTURE_GRASS));
         glm::mat4 model_matrix =
                 glm::translate(glm::identity<glm::dmat4>(), engine->prev_contacts[i]->p) *
-                glm::dmat4(engine->prev_contacts[i]->body_b->a) *
+                glm::mat4_cast(engine->prev_contacts[i]->body_b->q) *
                 glm::dmat4(glm::scale(glm::identity<glm::dmat4>(), glm::dvec3(.05)));
         ShaderProgram::set_mat4(contact_program, "modelMatrix", model_matrix);
         ShaderProgram::set_mat4(contact_program, "viewMatrix", camera->get_view_matrix());
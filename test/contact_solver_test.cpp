@@ -0,0 +1,173 @@
+#include <cstdlib>
+
+#include "test.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/math.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/**
+ * A = G * G^T for a random n by {rank} matrix G, which is positive semi-definite and singular if {rank} < n, as
+ * the matrix of contacts of which more than three lie on the same face of a body. */
+static math::SparseMatrix create_semi_definite(uint32_t n, uint32_t rank)
+{
+    std::vector<double> g(n * rank);
+    for (auto &value : g) {
+        value = random_unit();
+    }
+
+    math::SparseMatrix amat;
+    amat.n = n;
+    amat.row_start.emplace_back(0);
+    for (uint32_t i = 0; i < n; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            double sum = 0.;
+            for (uint32_t k = 0; k < rank; k++) {
+                sum += g[i * rank + k] * g[j * rank + k];
+            }
+            amat.columns.emplace_back(j);
+            amat.values.emplace_back(sum);
+        }
+        amat.row_start.emplace_back(amat.columns.size());
+    }
+
+    return amat;
+}
+
+/** Largest |A_CC * x_C - b_C| over the indices i in C, infinite if x_C is not finite. */
+static double solve_error(const math::SparseMatrix &amat, const std::vector<bool> &c, const double *x, const double *b)
+{
+    double error = 0.;
+    for (uint32_t i = 0; i < amat.n; i++) {
+        if (!c[i]) continue;
+        if (!std::isfinite(x[i])) return INFINITY;
+
+        double sum = -b[i];
+        for (uint32_t k = amat.row_start[i]; k < amat.row_start[i + 1]; k++) {
+            if (c[amat.columns[k]]) sum += amat.values[k] * x[amat.columns[k]];
+        }
+        error = std::max(error, std::abs(sum));
+    }
+
+    return error;
+}
+
+bool ldlt_test()
+{
+    const uint32_t N = 12;
+    const uint32_t RANK = 5;
+    const double TOLERANCE = 1.e-8;
+
+    std::srand(1);
+    uint32_t failures = 0;
+    for (uint32_t k = 0; k < 100; k++) {
+        math::SparseMatrix amat = create_semi_definite(N, RANK);
+
+        // b = A * x for a random x, such that A_CC * x_C = b_C has a solution for any C
+        std::vector<double> x_0(N);
+        for (auto &value : x_0) {
+            value = random_unit();
+        }
+        std::vector<double> b(N);
+        std::vector<double> x(N);
+
+        // add all indices, then remove every other one, solving after every change
+        math::LdltFactor factor;
+        factor.reset(&amat);
+        std::vector<bool> c(N, false);
+        for (uint32_t step = 0; step < N + N / 2; step++) {
+            if (step < N) {
+                factor.add(step);
+                c[step] = true;
+            } else {
+                factor.remove(2 * (step - N));
+                c[2 * (step - N)] = false;
+            }
+
+            for (uint32_t i = 0; i < N; i++) {
+                b[i] = 0.;
+                for (uint32_t j = 0; j < N; j++) {
+                    if (c[j]) b[i] += amat.get(i, j) * x_0[j];
+                }
+            }
+            factor.solve(x.data(), b.data());
+            if (!(solve_error(amat, c, x.data(), b.data()) <= TOLERANCE)) failures++;
+        }
+    }
+
+    printf("%u of %u solves of rank %u matrices of size up to %u failed\n", failures, 100 * (N + N / 2), RANK, N);
+    return failures == 0;
+}
+
+bool stable_scene_test()
+{
+    const uint32_t STEPS = 300;
+
+    // the cubes rest on four contacts each, which the warm start clamps together
+    for (bool warm_start : {false, true}) {
+        Engine engine;
+        engine.warm_start = warm_start;
+        engine.sleeping = false;
+        engine.threads = 1;
+        engine.contact_solver_type = DANTZIG;
+        engine.change_scene(new StableScene());
+        engine.run = true;
+        for (uint32_t i = 0; i < STEPS; i++) {
+            engine.update();
+        }
+
+        // the cubes of unit size stay on the surface
+        double deviation = 0.;
+        for (auto &body : engine.body_system->bodies) {
+            if (body.shape->get_inv_mass() == 0.) continue;
+            double error = std::abs(body.x.y - .5);
+            deviation = std::isfinite(error) ? std::max(deviation, error) : INFINITY;
+        }
+
+        printf("%u steps %s warm start: largest deviation of a cube from rest %.2e\n", STEPS,
+               warm_start ? "with" : "without", deviation);
+        if (!(deviation < Engine::DISTANCE_THRESHOLD)) return false;
+    }
+
+    return true;
+}
+
+bool finished_body_test()
+{
+    // the lower cube of {StackingScene} has reached the end of the step, as in a localized substep
+    Engine engine;
+    engine.threads = 1;
+    engine.change_scene(new StackingScene());
+    BodySystem *body_system = engine.body_system;
+    RigidBody *lower = &body_system->bodies[1];
+    RigidBody *upper = &body_system->bodies[2];
+    lower->finished = true;
+    glm::dvec3 lower_p = lower->p;
+
+    std::vector<Contact *> contacts = CollisionDetection::find_all_contacts(body_system);
+    Integrator::apply_forces(body_system);
+    const BodyState &state = body_system->body_state;
+    int32_t slot = state.slot[upper - body_system->bodies.data()];
+    double weight = glm::length(state.force[slot]);
+    CollisionHandling::compute_contact_forces(body_system, contacts);
+
+    // the finished cube supports the weight of the upper cube on its own
+    double support = 0.;
+    for (auto &contact : contacts) {
+        if (contact->body_a == upper || contact->body_b == upper) support += contact->force;
+    }
+    glm::dvec3 net_force = state.force[slot];
+
+    for (auto &contact : contacts) {
+        delete contact;
+    }
+
+    printf("%zu contacts, support %g of weight %g, net force %g, lower cube integrated %d\n", contacts.size(),
+           support, weight, glm::length(net_force), (int) (state.slot[1] >= 0));
+    return std::abs(support - weight) < 1.e-6 * weight && glm::length(net_force) < 1.e-6 * weight &&
+           state.slot[1] < 0 && lower->p == lower_p;
+}
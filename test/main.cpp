@@ -0,0 +1,40 @@
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include "test.hpp"
+
+struct Test {
+    const char *name;
+    bool (*run)();
+};
+
+static const Test TESTS[] = {
+        {"narrowphase", narrowphase_test},
+        {"roll", roll_test},
+        {"ldlt", ldlt_test},
+        {"stable_scene", stable_scene_test},
+        {"finished_body", finished_body_test},
+        {"solver_workspace", solver_workspace_test},
+        {"sleeping", sleeping_test},
+};
+
+/** Runs the tests named on the command line, or all of them if none are named. Fails if any of them fails. */
+int main(int argc, char **argv)
+{
+    bool passed = true;
+    for (auto &test : TESTS) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], test.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        printf("== %s ==\n", test.name);
+        bool test_passed = test.run();
+        printf("%s\n\n", test_passed ? "passed" : "FAILED");
+        passed = passed && test_passed;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
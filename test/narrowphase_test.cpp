@@ -0,0 +1,40 @@
+#include <cstdlib>
+
+#include "test.hpp"
+#include "simulation/collision.hpp"
+#include "simulation/gjk.hpp"
+
+/** Uniformly distributed in [-1, 1]. */
+static double random_unit()
+{
+    return 2. * (double) std::rand() / RAND_MAX - 1.;
+}
+
+/** Random orientation. */
+static glm::dmat3 random_orientation()
+{
+    glm::dvec3 axis(random_unit(), random_unit(), random_unit() + 2.);
+    return glm::dmat3(glm::rotate(glm::identity<glm::dmat4>(), M_PI * random_unit(), glm::normalize(axis)));
+}
+
+bool narrowphase_test()
+{
+    const uint32_t COUNT = 20000;
+    Box cube(1., 1., 1., 1.);
+
+    // the pairs of the narrowphase benchmark, at random directions and distances such that about half intersect
+    std::srand(1);
+    uint32_t disagreements = 0;
+    for (uint32_t i = 0; i < COUNT; i++) {
+        glm::dvec3 direction = glm::normalize(glm::dvec3(random_unit(), random_unit(), random_unit()));
+        RigidBody x(glm::dvec3(0.), random_orientation(), &cube);
+        RigidBody y(direction * (.8 + 1.2 * (double) std::rand() / RAND_MAX), random_orientation(), &cube);
+
+        bool sat = Collision::intersect(&x, &y, 0.).intersect;
+        bool gjk = Gjk::overlap(&x, &y, 0.);
+        if (sat != gjk) disagreements++;
+    }
+
+    printf("%u of %u pairs of cubes classified differently\n", disagreements, COUNT);
+    return disagreements == 0;
+}
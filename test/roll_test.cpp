@@ -0,0 +1,39 @@
+#include "test.hpp"
+#include "simulation/engine.hpp"
+#include "simulation/sleeping.hpp"
+
+/** Returns whether no body of {engine} is moved by the simulation any more. */
+static bool asleep(const Engine &engine)
+{
+    for (auto &body : engine.body_system->bodies) {
+        if (Sleeping::is_active(&body)) return false;
+    }
+
+    return true;
+}
+
+bool roll_test()
+{
+    const uint32_t ROLLS = 8;
+    const uint32_t MAX_STEPS = 1000;
+
+    bool passed = true;
+    for (uint32_t seed = 0; seed < ROLLS; seed++) {
+        Engine engine;
+        engine.threads = 1;
+        engine.change_scene(new RollScene(2, seed));
+        engine.run = true;
+        uint32_t steps = 0;
+        while (steps < MAX_STEPS && !asleep(engine)) {
+            engine.update();
+            steps++;
+        }
+
+        printf("seed %u: %s after %u steps, %u impacts, %u truncated steps\n", seed,
+               asleep(engine) ? "asleep" : "awake", steps, (uint32_t) engine.impacts,
+               (uint32_t) engine.truncated_steps);
+        passed = passed && asleep(engine) && engine.truncated_steps == 0;
+    }
+
+    return passed;
+}
@@ -0,0 +1,41 @@
+#include "test.hpp"
+#include "simulation/engine.hpp"
+
+bool sleeping_test()
+{
+    // {BodySystem::sleep_time} is half a second, or 30 steps
+    const uint32_t SETTLE_STEPS = 60;
+    const uint32_t STEPS = 10;
+
+    Engine engine;
+    engine.threads = 1;
+    engine.change_scene(new PilesScene(2, 2, 1));
+    engine.run = true;
+    for (uint32_t i = 0; i < SETTLE_STEPS; i++) {
+        engine.update();
+    }
+
+    // push the first sleeping cube sideways, as code outside of {BodySystem::forces} would
+    std::vector<RigidBody> &bodies = engine.body_system->bodies;
+    uint32_t pushed = bodies.size();
+    for (uint32_t i = 0; i < bodies.size(); i++) {
+        if (bodies[i].asleep) {
+            pushed = i;
+            break;
+        }
+    }
+    if (pushed == bodies.size()) {
+        printf("no body fell asleep in %u steps\n", SETTLE_STEPS);
+        return false;
+    }
+
+    glm::dvec3 x = bodies[pushed].x;
+    bodies[pushed].p = glm::dvec3(1. / bodies[pushed].shape->get_inv_mass(), 0., 0.);
+    for (uint32_t i = 0; i < STEPS; i++) {
+        engine.update();
+    }
+
+    double moved = glm::length(bodies[pushed].x - x);
+    printf("pushed body %u moved %g in %u steps, asleep %d\n", pushed, moved, STEPS, (int) bodies[pushed].asleep);
+    return !bodies[pushed].asleep && moved > 0.;
+}
@@ -0,0 +1,29 @@
+#include "test.hpp"
+#include "simulation/engine.hpp"
+
+bool solver_workspace_test()
+{
+    const uint32_t WARM_UP_STEPS = 3;
+    const uint32_t STEPS = 10;
+
+    // without warm starting, such that every step pivots
+    Engine engine;
+    engine.warm_start = false;
+    engine.sleeping = false;
+    engine.threads = 1;
+    engine.change_scene(new PilesScene(4, 4, 2));
+    engine.run = true;
+    for (uint32_t i = 0; i < WARM_UP_STEPS; i++) {
+        engine.update();
+    }
+
+    const math::SolverWorkspace &workspace = engine.body_system->solver_workspaces[0];
+    uint64_t growths = workspace.allocations;
+    for (uint32_t i = 0; i < STEPS; i++) {
+        engine.update();
+    }
+    growths = workspace.allocations - growths;
+
+    printf("%u workspace growths in %u steps after %u steps\n", (uint32_t) growths, STEPS, WARM_UP_STEPS);
+    return growths == 0;
+}
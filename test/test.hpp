@@ -0,0 +1,40 @@
+#ifndef TEST_TEST_HPP
+#define TEST_TEST_HPP
+
+#include <cstdio>
+#include <cstdint>
+
+/*
+ * Regression tests, each prints what it checked and returns whether it passed.
+ */
+
+/**
+ * Random pairs of cubes are classified alike by the separating plane scan and GJK, including pairs which are only
+ * separated by a plane through an edge of one cube, of which the vertices lie on the plane up to rounding. */
+bool narrowphase_test();
+
+/**
+ * Two dice of {RollScene} fall asleep for the first seeds, without a step being dropped, where a die resting on a
+ * corner used to sink past the penetration limit and stall every step. */
+bool roll_test();
+
+/**
+ * {math::LdltFactor} solves A_CC * x_C = b_C as C grows and shrinks, where A is positive semi-definite and A_CC
+ * becomes singular, as long as a solution exists. */
+bool ldlt_test();
+
+/** {StableScene} runs for 300 steps with the pivoting solver, with and without warm start, and stays at rest. */
+bool stable_scene_test();
+
+/**
+ * The upper cube of {StackingScene} rests on the lower one after that one has been finished, as in a localized
+ * substep, which then supports its full weight as an immovable body would. */
+bool finished_body_test();
+
+/** The workspace of the contact force solver does not grow once {PilesScene} has been stepped a few times. */
+bool solver_workspace_test();
+
+/** A sleeping cube of {PilesScene} which is given momentum from outside of the forces wakes and moves. */
+bool sleeping_test();
+
+#endif //TEST_TEST_HPP